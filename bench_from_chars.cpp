@@ -0,0 +1,1056 @@
+#if 0
+rm -f ./_bench_from_chars ./_bench_*.o
+cc -Wall -O3 -c -I . -I ../callback_printf ../callback_printf/callback_printf.c -o _bench_cbp.o
+cc -Wall -O3 -c -I . -I ../callback_printf ../callback_printf/sfprintf.c -o _bench_sfp.o
+cc -Wall -O3 -c -I . str2num.c -o _bench_s2n.o
+cc -Wall -O3 -c -I . str2num_batch.c -o _bench_batch.o
+cc -Wall -O3 -c -I . str2num_file.c -o _bench_file.o
+c++ -std=c++20 -Wall -O3 -DBENCH_CFLAGS='"-std=c++20 -Wall -O3"' -o _bench_from_chars -I . -I ../callback_printf bench_from_chars.cpp _bench_*.o -lpthread
+rm -f ./_bench_*.o
+./_bench_from_chars
+exit $?
+#endif
+
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME:      bench_from_chars.cpp                                        *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION:   comparison of str2num with std::from_chars                  *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT:     (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)             *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN:        https://github.com/klux21/str2num                           *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* Civil Usage Public License, Version 1.2, June 2026                          *
+*                                                                             *
+* Redistribution and use in source and binary forms, with or without          *
+* modification, are permitted provided that the following conditions are met: *
+*                                                                             *
+* 1. Redistributions of source code must retain the above copyright           *
+*    notice, this list of conditions, the explanation of terms                *
+*    and the following disclaimer.                                            *
+*                                                                             *
+* 2. Redistributions in binary form must reproduce the above copyright        *
+*    notice, this list of conditions and the following disclaimer in the      *
+*    documentation or other materials provided with the distribution.         *
+*                                                                             *
+* 3. All modified files must carry prominent notices stating that the         *
+*    files have been changed.                                                 *
+*                                                                             *
+* 4. The source code and binary forms and any derivative works are not        *
+*    stored or executed in systems or devices which are designed or           *
+*    intended to harm, to kill or to forcibly immobilize people.              *
+*                                                                             *
+* 5. The source code and binary forms and any derivative works are not        *
+*    stored or executed in systems or devices which are intended to           *
+*    monitor, to track, to change or to control the behavior, the             *
+*    constitution, the location or the communication of any people or         *
+*    their property without the explicit and prior agreement of those         *
+*    people except those devices and systems are solely designed for          *
+*    saving or protecting peoples life or health.                             *
+*                                                                             *
+* 6. The source code and binary forms and any derivative works are not        *
+*    stored or executed in any systems or devices that are intended           *
+*    for the production of any of the systems or devices that                 *
+*    have been stated before except the ones for saving or protecting         *
+*    peoples life or health only.                                             *
+*                                                                             *
+* The term 'systems' in all clauses shall include all types and combinations  *
+* of physical, virtualized or simulated hardware and software and any kind    *
+* of data storage.                                                            *
+*                                                                             *
+* The term 'devices' shall include any kind of local or non-local control     *
+* system of the stated devices as part of that device as well. Any assembly   *
+* of more than one device is one and the same device regarding this license.  *
+*                                                                             *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE   *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+* POSSIBILITY OF SUCH DAMAGE.                                                 *
+*                                                                             *
+\*****************************************************************************/
+/* The benchmark suite of bench_str2num.c is reused for identical inputs, timings and result files. */
+#define BENCH_SUITE_ONLY
+#include "bench_str2num.c"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <str2num.hpp>
+
+#if defined (__cpp_impl_coroutine) && defined (__cpp_lib_ranges)
+#include <str2num_coro.hpp>
+#endif
+
+/* ------------------------------------------------------------------------- *\
+   Conversion loops
+\* ------------------------------------------------------------------------- */
+
+/* ends of the strings of the current input for std::from_chars */
+static char * const *              fc_pps = NULL;
+static std::vector<const char *>   fc_end;
+
+/* ------------------------------------------------------------------------- *\
+   fc_parse converts a string by std::from_chars. Leading blanks are skipped
+   like str2num does and the floating point numbers of base 16 or 0 may have
+   a 0x prefix which std::from_chars doesn't accept by itself.
+\* ------------------------------------------------------------------------- */
+template <typename T>
+static std::from_chars_result fc_parse(const char * ps, const char * pend, T & v, int base)
+{
+   while((ps < pend) && ((*ps == ' ') || (*ps == '\t')))
+      ++ps;
+
+   if constexpr (std::is_integral<T>::value)
+   {
+      return (std::from_chars(ps, pend, v, base));
+   }
+   else
+   {
+      const char *           pm  = ps + (*ps == '-');
+      std::from_chars_result res;
+
+      if(((base == 0) || (base == 16)) && (pend - pm > 2) && (pm[0] == '0') && ((pm[1] | 0x20) == 'x'))
+      {
+         res = std::from_chars(pm + 2, pend, v, std::chars_format::hex);
+         if((res.ec == std::errc()) && (pm != ps))
+            v = -v;
+         if(res.ptr == pm + 2)
+            res.ptr = ps;
+         return (res);
+      }
+
+      return (std::from_chars(ps, pend, v, (base == 16) ? std::chars_format::hex : std::chars_format::general));
+   }
+}/* std::from_chars_result fc_parse(...) */
+
+
+/* conversion loop of std::from_chars */
+template <typename T>
+static uint64_t loop_fc(char * const * pps, size_t count, int base)
+{
+   const char * const * pend = &fc_end[(size_t) (pps - fc_pps)];
+   uint64_t             s    = 0;
+   size_t               i;
+
+   for(i = 0; i < count; ++i)
+   {
+      T v = 0;
+      fc_parse(pps[i], pend[i], v, base);
+
+      if constexpr (std::is_integral<T>::value)
+         s += (uint64_t) v;
+      else
+         s += float_bits(v);
+   }
+
+   return (s);
+}/* uint64_t loop_fc(char * const * pps, size_t count, int base) */
+
+
+/* conversion loop of a str2num function */
+template <typename T, T (* fn) (const char *, char **, int, int *)>
+static uint64_t loop_s2n(char * const * pps, size_t count, int base)
+{
+   uint64_t s = 0;
+   size_t   i;
+
+   for(i = 0; i < count; ++i)
+   {
+      if constexpr (std::is_integral<T>::value)
+         s += (uint64_t) fn(pps[i], NULL, base, NULL);
+      else
+         s += float_bits(fn(pps[i], NULL, base, NULL));
+   }
+
+   return (s);
+}/* uint64_t loop_s2n(char * const * pps, size_t count, int base) */
+
+
+/* conversion loop of s2n::str2int_r */
+template <typename T>
+static uint64_t loop_hpp(char * const * pps, size_t count, int base)
+{
+   const char * const * pend = &fc_end[(size_t) (pps - fc_pps)];
+   uint64_t             s    = 0;
+   size_t               i;
+
+   for(i = 0; i < count; ++i)
+      s += (uint64_t) s2n::str2int_r<T>(pps[i], pend[i], NULL, base, NULL);
+
+   return (s);
+}/* uint64_t loop_hpp(char * const * pps, size_t count, int base) */
+
+
+/* s2n::str2int_r with the interface of the C functions for the comparisons */
+template <typename T>
+static T hpp_r(const char * ps, char ** pe, int base, int * perr)
+{
+   return (s2n::str2int_r<T>(ps, ps + strlen(ps), (const char **) pe, base, perr));
+}/* T hpp_r(const char * ps, char ** pe, int base, int * perr) */
+
+
+/* str2num has no reentrant float variant and str2f returns the rounded double of str2d_r */
+static float str2f_base_r(const char * ps, char ** pe, int base, int * perr)
+{
+   return ((float) str2d_r(ps, pe, base, perr));
+}/* float str2f_base_r(const char * ps, char ** pe, int base, int * perr) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Result comparison
+\* ------------------------------------------------------------------------- */
+
+/* differences of the results of a str2num function and std::from_chars */
+typedef struct FC_DIFF_S FC_DIFF;
+struct FC_DIFF_S
+{
+   size_t   values;  /* number of different values of valid conversions */
+   size_t   ends;    /* number of different end positions */
+   size_t   errors;  /* number of different error classes (none, out of range, invalid) */
+   uint64_t max_ulp; /* maximum difference in units of the last place of floating point values */
+};
+
+/* ------------------------------------------------------------------------- *\
+   fc_ulp returns the distance of two floating point numbers in units in the
+   last place or 0 for long double values that are just compared bitwise
+\* ------------------------------------------------------------------------- */
+template <typename T>
+static uint64_t fc_ulp(T a, T b)
+{
+   if constexpr (sizeof(T) == sizeof(uint32_t))
+   {
+      int32_t ia;
+      int32_t ib;
+      memcpy(&ia, &a, sizeof(ia));
+      memcpy(&ib, &b, sizeof(ib));
+      ia = (ia < 0) ? INT32_MIN - ia : ia;
+      ib = (ib < 0) ? INT32_MIN - ib : ib;
+      return ((ia > ib) ? (uint64_t) ((int64_t) ia - ib) : (uint64_t) ((int64_t) ib - ia));
+   }
+   else if constexpr (sizeof(T) == sizeof(uint64_t))
+   {
+      int64_t ia;
+      int64_t ib;
+      memcpy(&ia, &a, sizeof(ia));
+      memcpy(&ib, &b, sizeof(ib));
+      ia = (ia < 0) ? INT64_MIN - ia : ia;
+      ib = (ib < 0) ? INT64_MIN - ib : ib;
+      return ((ia > ib) ? (uint64_t) ia - (uint64_t) ib : (uint64_t) ib - (uint64_t) ia);
+   }
+   else
+   {
+      return (0);
+   }
+}/* uint64_t fc_ulp(T a, T b) */
+
+
+/* ------------------------------------------------------------------------- *\
+   fc_compare compares the values, end positions and errors of a str2num
+   function with the ones of std::from_chars for all strings of an input.
+   Values are only compared if both conversions succeed.
+\* ------------------------------------------------------------------------- */
+template <typename T, T (* fn) (const char *, char **, int, int *)>
+static void fc_compare(const BENCH_INPUT * pin, FC_DIFF * pd)
+{
+   size_t i;
+
+   memset(pd, 0, sizeof(*pd));
+
+   for(i = 0; i < pin->count; ++i)
+   {
+      const char *           ps  = pin->pps[i];
+      char *                 pe  = NULL;
+      int                    err = 0;
+      T                      v0  = fn(ps, &pe, pin->base, &err);
+      T                      v1  = 0;
+      std::from_chars_result res = fc_parse(ps, fc_end[i], v1, pin->base);
+      int                    e0  = !err ? 0 : (err == ERANGE) ? 1 : 2;
+      int                    e1  = (res.ec == std::errc()) ? 0 : (res.ec == std::errc::result_out_of_range) ? 1 : 2;
+
+      if(e0 != e1)
+         ++pd->errors;
+
+      if((e0 != 2) && (e1 != 2) && (pe != res.ptr))
+         ++pd->ends;
+
+      if(!e0 && !e1 && memcmp(&v0, &v1, std::is_integral<T>::value ? sizeof(T) : (sizeof(T) > 8 ? 10 : sizeof(T))))
+      {
+         ++pd->values;
+
+         if constexpr (!std::is_integral<T>::value)
+         {
+            uint64_t ulp = fc_ulp(v0, v1);
+            if(ulp > pd->max_ulp)
+               pd->max_ulp = ulp;
+         }
+      }
+   }
+}/* void fc_compare(const BENCH_INPUT * pin, FC_DIFF * pd) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Benchmark
+\* ------------------------------------------------------------------------- */
+
+/* str2num function and the matching std::from_chars overload */
+typedef struct FC_PAIR_S FC_PAIR;
+struct FC_PAIR_S
+{
+   const char * name;                                      /* name of the str2num function */
+   const char * fc_name;                                   /* name of the std::from_chars overload */
+   int          kind;                                      /* BK_INT or BK_FLOAT */
+   BENCH_LOOP   s2n;                                       /* conversion loop of str2num */
+   BENCH_LOOP   fc;                                        /* conversion loop of std::from_chars */
+   void      (* compare) (const BENCH_INPUT * pin, FC_DIFF * pd); /* comparison of the results */
+};
+
+#define FC_PAIR_INT(name, fc_name, T, fn)   { name, fc_name, BK_INT,   loop_s2n<T, fn>, loop_fc<T>, fc_compare<T, fn> }
+#define FC_PAIR_FLOAT(name, fc_name, T, fn) { name, fc_name, BK_FLOAT, loop_s2n<T, fn>, loop_fc<T>, fc_compare<T, fn> }
+#define FC_PAIR_HPP(name, fc_name, T)       { name, fc_name, BK_INT,   loop_hpp<T>, loop_fc<T>, fc_compare<T, hpp_r<T> > }
+
+static const FC_PAIR fc_pairs[] =
+{
+   FC_PAIR_INT   ("str2i8_r",  "fc_int8",    int8_t,      str2i8_r),
+   FC_PAIR_INT   ("str2u8_r",  "fc_uint8",   uint8_t,     str2u8_r),
+   FC_PAIR_INT   ("str2i16_r", "fc_int16",   int16_t,     str2i16_r),
+   FC_PAIR_INT   ("str2u16_r", "fc_uint16",  uint16_t,    str2u16_r),
+   FC_PAIR_INT   ("str2i32_r", "fc_int32",   int32_t,     str2i32_r),
+   FC_PAIR_INT   ("str2u32_r", "fc_uint32",  uint32_t,    str2u32_r),
+   FC_PAIR_INT   ("str2i64_r", "fc_int64",   int64_t,     str2i64_r),
+   FC_PAIR_INT   ("str2u64_r", "fc_uint64",  uint64_t,    str2u64_r),
+   FC_PAIR_HPP   ("hpp_int32", "fc_int32",   int32_t),
+   FC_PAIR_HPP   ("hpp_uint32","fc_uint32",  uint32_t),
+   FC_PAIR_HPP   ("hpp_int64", "fc_int64",   int64_t),
+   FC_PAIR_HPP   ("hpp_uint64","fc_uint64",  uint64_t),
+#if defined (__cpp_lib_to_chars)
+   /* the floating point overloads are only available with a complete <charconv> */
+   FC_PAIR_FLOAT ("str2f",     "fc_float",   float,       str2f_base_r),
+   FC_PAIR_FLOAT ("str2d_r",   "fc_double",  double,      str2d_r),
+   FC_PAIR_FLOAT ("str2ld_r",  "fc_ldouble", long double, str2ld_r),
+#endif
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   fc_input benchmarks and compares all selected pairs that match the kind
+   of an input
+\* ------------------------------------------------------------------------- */
+static int fc_input(const BENCH_INPUT * pin, const BENCH_OPT * popt)
+{
+   size_t i;
+
+   /* std::from_chars requires the end of each string */
+   fc_pps = pin->pps;
+   fc_end.resize(pin->count);
+   for(i = 0; i < pin->count; ++i)
+      fc_end[i] = pin->pps[i] + strlen(pin->pps[i]);
+
+   for(i = 0; i < ARRAY_SIZE(fc_pairs); ++i)
+   {
+      const FC_PAIR * pp = &fc_pairs[i];
+      BENCH_FUNC      f0 = { pp->name,    pp->kind, pp->s2n };
+      BENCH_FUNC      f1 = { pp->fc_name, pp->kind, pp->fc  };
+      BENCH_RESULT    r0;
+      BENCH_RESULT    r1;
+      FC_DIFF         d;
+
+      if((pp->kind != pin->kind) || !name_selected(popt->pfuncs, pp->name))
+         continue;
+
+      if((pin->kind == BK_INT) && ((pin->base < 2) || (pin->base > 36)))
+         continue; /* std::from_chars doesn't detect the base */
+
+      if(!bench_measure(&f0, pin, popt, &r0) || !bench_measure(&f1, pin, popt, &r1))
+         return (0);
+
+      pp->compare(pin, &d);
+
+      sfprintf(stdout, "%-10s %-14s %-15s %9.2f %9.2f %7.2fx %8lu %8lu %8lu %8llu\n", pin->name, pp->name, pp->fc_name,
+               r0.ns_median, r1.ns_median, (r0.ns_median > 0.0) ? r1.ns_median / r0.ns_median : 0.0,
+               (unsigned long) d.values, (unsigned long) d.ends, (unsigned long) d.errors, (unsigned long long) d.max_ulp);
+
+      if(!record_add(pp->name, pin->name, &r0) || !record_add(pp->fc_name, pin->name, &r1))
+         return (0);
+   }
+
+   return (1);
+}/* int fc_input(const BENCH_INPUT * pin, const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Tests of str2num.hpp
+\* ------------------------------------------------------------------------- */
+
+/* hpp_check compares a result of s2n::from_chars with the expected one */
+template <typename T>
+static int hpp_check(const char * ps, size_t len, int base, T expected, size_t end, std::errc ec)
+{
+   T                      v   = (T) 99;
+   std::from_chars_result res = s2n::from_chars(ps, ps + len, v, base);
+
+   if((res.ec != ec) || ((size_t) (res.ptr - ps) != end) || ((ec == std::errc()) ? (v != expected) : (v != (T) 99)))
+   {
+      sfprintf(stderr, "Unexpected result of s2n::from_chars(\"%.*s\", %d) (end %d, error %d)!\n",
+               (int) len, ps, base, (int) (res.ptr - ps), (int) res.ec);
+      return (0);
+   }
+
+   return (1);
+}/* int hpp_check(...) */
+
+
+/* strong typedef of a 64 bit integer for the tests of s2n::str2int_r */
+struct HPP_LENGTH
+{
+   int64_t v;
+
+   constexpr HPP_LENGTH() : v(0) {}
+   constexpr HPP_LENGTH(int64_t x) : v(x) {}
+
+   constexpr HPP_LENGTH operator + (HPP_LENGTH o) const { return (HPP_LENGTH(v + o.v)); }
+   constexpr HPP_LENGTH operator - (HPP_LENGTH o) const { return (HPP_LENGTH(v - o.v)); }
+   constexpr HPP_LENGTH operator * (HPP_LENGTH o) const { return (HPP_LENGTH(v * o.v)); }
+   constexpr HPP_LENGTH operator / (HPP_LENGTH o) const { return (HPP_LENGTH(v / o.v)); }
+   constexpr HPP_LENGTH operator - ()             const { return (HPP_LENGTH(-v)); }
+   constexpr bool       operator == (HPP_LENGTH o) const { return (v == o.v); }
+   constexpr bool       operator != (HPP_LENGTH o) const { return (v != o.v); }
+   constexpr bool       operator <  (HPP_LENGTH o) const { return (v <  o.v); }
+   constexpr bool       operator >  (HPP_LENGTH o) const { return (v >  o.v); }
+   constexpr bool       operator <= (HPP_LENGTH o) const { return (v <= o.v); }
+   constexpr bool       operator >= (HPP_LENGTH o) const { return (v >= o.v); }
+};
+
+namespace std
+{
+template <> struct numeric_limits<HPP_LENGTH>
+{
+   static constexpr bool is_specialized = true;
+   static constexpr bool is_signed      = true;
+   static constexpr bool is_integer     = true;
+   static constexpr HPP_LENGTH min() { return (HPP_LENGTH(INT64_MIN)); }
+   static constexpr HPP_LENGTH max() { return (HPP_LENGTH(INT64_MAX)); }
+};
+}
+
+
+/* native_compare compares s2n::str2int_r with the C function of the same type */
+template <typename T, T (* fn) (const char *, char **, int, int *)>
+static int native_compare(const char * ps, int base)
+{
+   char *       pe0  = NULL;
+   const char * pe1  = NULL;
+   int          err0 = 0;
+   int          err1 = 0;
+   T            v0   = fn(ps, &pe0, base, &err0);
+   T            v1   = s2n::str2int_r<T>(ps, ps + strlen(ps), &pe1, base, &err1);
+
+   if((v0 != v1) || (pe0 != pe1) || (err0 != err1))
+   {
+      sfprintf(stderr, "Different results of s2n::str2int_r and the C function of size %d for \"%s\" and base %d (%lld/%lld, end %d/%d, error %d/%d)!\n",
+               (int) sizeof(T), ps, base, (long long) v0, (long long) v1, (int) (pe0 - ps), (int) (pe1 - ps), err0, err1);
+      return (0);
+   }
+
+   return (1);
+}/* int native_compare(const char * ps, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_native compares the native templates of str2num.hpp with the integer
+   functions of str2num.c
+\* ------------------------------------------------------------------------- */
+static int test_native()
+{
+   static const char * const strings[] =
+   {
+      "0", "  123", "-0x1f", "0x", "0xg", "0o7", "0o8", "0b102", "+-1", "-", "", "0129", "zz", "z~", " \t-007", "1e5",
+      "127", "128", "-128", "-129", "255", "256", "-255", "-256", "32767", "32768", "-32769", "65535", "65536",
+      "2147483647", "2147483648", "-2147483649", "4294967295", "4294967296", "-4294967296",
+      "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+      "18446744073709551615", "18446744073709551616", "-18446744073709551616", "184467440737095516150",
+      "1111111111111111111111111111111111111111111111111111111111111111", "11111111111111111111111111111111111111111111111111111111111111111",
+      "ffffffffffffffff", "10000000000000000", "7fffffffffffffff", "-8000000000000000", "-8000000000000001",
+      "3w5e11264sgsf", "3w5e11264sgsg", "1y2p0ij32e8e7", "1y2p0ij32e8e8", "zzzzzzzzzzzzzzzzzz"
+   };
+   static const int bases[] = { 0, 1, 2, 8, 10, 16, 35, 36, 37, -1 };
+   HPP_LENGTH   len;
+   const char * pe  = NULL;
+   int          err = 0;
+   size_t       i;
+   size_t       b;
+
+   for(i = 0; i < ARRAY_SIZE(strings); ++i)
+   {
+      for(b = 0; b < ARRAY_SIZE(bases); ++b)
+      {
+         const char * ps   = strings[i];
+         int          base = bases[b];
+
+         if(!native_compare<int8_t,   str2i8_r>  (ps, base) || !native_compare<uint8_t,  str2u8_r> (ps, base) ||
+            !native_compare<int16_t,  str2i16_r> (ps, base) || !native_compare<uint16_t, str2u16_r>(ps, base) ||
+            !native_compare<int32_t,  str2i32_r> (ps, base) || !native_compare<uint32_t, str2u32_r>(ps, base) ||
+            !native_compare<int64_t,  str2i64_r> (ps, base) || !native_compare<uint64_t, str2u64_r>(ps, base))
+            return (0);
+      }
+   }
+
+   /* the end of the range stops the conversion */
+   if((s2n::str2int_r<int>("12345", "12345" + 3, &pe, 10, &err) != 123) || err ||
+      (s2n::str2int_r<unsigned>("0x1f", "0x1f" + 2, &pe, 0, &err) != 0) || err)
+   {
+      sfprintf(stderr, "s2n::str2int_r reads behind the end of a range!\n");
+      return (0);
+   }
+
+   /* fixed numeric base and a strong typedef */
+   len = s2n::str2int_r<HPP_LENGTH, 16>("-7fffffffffffffff", "-7fffffffffffffff" + 17, &pe, 0, &err);
+   if((s2n::str2int_r<uint64_t, 16>("0xffffffffffffffff", "0xffffffffffffffff" + 18, &pe, 0, &err) != UINT64_MAX) ||
+      (len.v != -INT64_MAX) || (s2n::str2int_r<HPP_LENGTH>("-9223372036854775809", "-9223372036854775809" + 20, &pe, 10, &err).v != INT64_MIN) ||
+      (err != ERANGE))
+   {
+      sfprintf(stderr, "Unexpected result of s2n::str2int_r with a fixed base or a strong typedef!\n");
+      return (0);
+   }
+
+   return (1);
+}/* int test_native() */
+
+
+/* flt_f_r converts a float like str2f but with a base */
+static float flt_f_r(const char * ps, char ** pe, int base, int * perr)
+{
+   return ((float) str2d_r(ps, pe, base, perr));
+}/* float flt_f_r(const char * ps, char ** pe, int base, int * perr) */
+
+
+/* flt_compare compares s2n::str2flt_r with the C function of the same type */
+template <typename T, T (* fn) (const char *, char **, int, int *)>
+static int flt_compare(const char * ps, int base)
+{
+   char *       pe0  = NULL;
+   const char * pe1  = NULL;
+   int          err0 = 0;
+   int          err1 = 0;
+   T            v0   = fn(ps, &pe0, base, &err0);
+   T            v1   = s2n::str2flt_r<T>(ps, ps + strlen(ps), &pe1, base, &err1);
+
+   if(((v0 != v1) && !(std::isnan(v0) && std::isnan(v1))) || (std::signbit(v0) != std::signbit(v1)) ||
+      (pe0 != pe1) || (err0 != err1))
+   {
+      sfprintf(stderr, "Different results of s2n::str2flt_r and the C function of size %d for \"%s\" and base %d (%La/%La, end %d/%d, error %d/%d)!\n",
+               (int) sizeof(T), ps, base, (long double) v0, (long double) v1, (int) (pe0 - ps), (int) (pe1 - ps), err0, err1);
+      return (0);
+   }
+
+   return (1);
+}/* int flt_compare(const char * ps, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_native_float compares s2n::str2flt_r with the floating point functions
+   of str2num.c
+\* ------------------------------------------------------------------------- */
+static int test_native_float()
+{
+   static const char * const strings[] =
+   {
+      "0", "-0", "  1.5", "+.5", ".", "-.", "1.", "0.1", "0.3", "123.456e-7", "1e22", "1e23", "9007199254740993",
+      "1.7976931348623157e308", "1.8e308", "4.9e-324", "2.4e-324", "1e-400", "1e99", "1e100", "1e-99", "1e-100",
+      "123456789012345678901234567890", "0.000000000000000000001234567890123456789012345678901234567890",
+      "1e", "1e+", "1e-", "1e+5", "1E-5x", "1~3", "1.5~-3", "0x1.8p3", "0X1P-1074", "-0x1.fffffffffffffp1023", "0x1p",
+      "0b101.1", "0o17.4", "0x", "0xg", "inf", "-INF", "infinity", "InFiNiTyx", "infx", "nan", "-nan", "nanx", "in",
+      "zz.z", "z~z", "1e1111111111111111", "0e1000000000", "1e-1000000000", "    ", "-", "+-1", "0129.5", "08"
+   };
+   static const int bases[] = { 0, 1, 2, 8, 10, 16, 23, 24, 34, 35, 36, 37, -1 };
+   size_t i;
+   size_t b;
+
+   for(i = 0; i < ARRAY_SIZE(strings); ++i)
+   {
+      for(b = 0; b < ARRAY_SIZE(bases); ++b)
+      {
+         if(!flt_compare<float, flt_f_r>(strings[i], bases[b]) || !flt_compare<double, str2d_r>(strings[i], bases[b]) ||
+            !flt_compare<long double, str2ld_r>(strings[i], bases[b]))
+            return (0);
+      }
+   }
+
+   return (1);
+}/* int test_native_float() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_constexpr tests the conversions of str2num.hpp at compile time
+\* ------------------------------------------------------------------------- */
+
+/* constexpr_int converts a string to an int by s2n::from_chars */
+static constexpr int constexpr_int(std::string_view sv, int base)
+{
+   int v = -1;
+
+   s2n::from_chars(sv, v, base);
+   return (v);
+}/* int constexpr_int(std::string_view sv, int base) */
+
+/* constexpr_literal returns the error of a user defined literal of the base BASE */
+template <int BASE>
+static constexpr int constexpr_literal(std::string_view sv)
+{
+   unsigned long long v = 0;
+
+   return (s2n::detail::literal_error<BASE>(sv.data(), sv.size(), &v));
+}/* int constexpr_literal(std::string_view sv) */
+
+static int test_constexpr()
+{
+   using namespace s2n::literals;
+
+   static_assert("zz"_b36 == 1295, "zz"); /* compile time tests */
+   static_assert("7f"_b16 == 127, "7f");
+   static_assert("1111111111111111111111111111111111111111111111111111111111111111"_b2 == UINT64_MAX, "_b2");
+   static_assert(constexpr_int("0b1010", 0) == 10, "0b1010");
+   static_assert(constexpr_literal<10>("18446744073709551615") == 0, "UINT64_MAX");
+
+   /* literals that fail at compile time */
+   static_assert(constexpr_literal<10>("-1") == EINVAL, "-1");
+   static_assert(constexpr_literal<10>("-18446744073709551615") == EINVAL, "-18446744073709551615");
+   static_assert(constexpr_literal<10>("+1") == EINVAL, "+1");
+   static_assert(constexpr_literal<10>(" 1") == EINVAL, "blank");
+   static_assert(constexpr_literal<10>("") == EINVAL, "empty");
+   static_assert(constexpr_literal<16>("0x7f") == EINVAL, "0x7f");
+   static_assert(constexpr_literal<2>("0b1") == EINVAL, "0b1");
+   static_assert(constexpr_literal<10>("18446744073709551616") == ERANGE, "18446744073709551616");
+   static_assert(constexpr_int("2147483648", 10) == -1, "2147483648");
+   static_assert(s2n::str2flt_r<double>("1.5e3", "1.5e3" + 5, NULL, 10, NULL) == 1500.0, "1.5e3");
+   static_assert(s2n::str2flt_r<float>("0x1p-2", "0x1p-2" + 6, NULL, 0, NULL) == 0.25f, "0x1p-2");
+   static_assert(s2n::str2int_r<int8_t>("-128", "-128" + 4, NULL, 10, NULL) == -128, "-128");
+
+   {
+      constexpr long double v = s2n::str2flt_r<long double>("-1.25", "-1.25" + 5, NULL, 10, NULL);
+      long double           r = str2ld_r("-1.25", NULL, 10, NULL);
+
+      if(v != r)
+      {
+         sfprintf(stderr, "Different results of s2n::str2flt_r at compile time and at runtime!\n");
+         return (0);
+      }
+   }
+
+   /* invalid literals that aren't constant expressions throw at runtime */
+   try
+   {
+      volatile unsigned long long v = operator""_b16("10000000000000000", 17);
+      (void) v;
+      sfprintf(stderr, "The literal _b16 doesn't detect an overflow!\n");
+      return (0);
+   }
+   catch(const std::out_of_range &)
+   {}
+
+   try
+   {
+      volatile unsigned long long v = operator""_b10("12a", 3);
+      (void) v;
+      sfprintf(stderr, "The literal _b10 doesn't detect an invalid digit!\n");
+      return (0);
+   }
+   catch(const std::invalid_argument &)
+   {}
+
+   try
+   {
+      volatile unsigned long long v = operator""_b10("-1", 2);
+      (void) v;
+      sfprintf(stderr, "The literal _b10 accepts a sign!\n");
+      return (0);
+   }
+   catch(const std::invalid_argument &)
+   {}
+
+   return (1);
+}/* int test_constexpr() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_hpp tests s2n::from_chars of str2num.hpp
+\* ------------------------------------------------------------------------- */
+static int test_hpp()
+{
+   const std::errc ok    = std::errc();
+   const std::errc range = std::errc::result_out_of_range;
+   const std::errc inval = std::errc::invalid_argument;
+   std::string     big(300, '0');
+   double          d     = 0.0;
+
+   big += "12.5";
+
+   if(!hpp_check<int32_t> ("123456", 3, 10, 123, 3, ok) ||      /* the range ends before the string */
+      !hpp_check<int32_t> (" -42x", 5, 10, -42, 4, ok) ||
+      !hpp_check<int8_t>  ("300", 3, 10, 0, 3, range) ||
+      !hpp_check<uint16_t>("65536", 5, 10, 0, 5, range) ||
+      !hpp_check<uint64_t>("0x1fz", 5, 0, 31, 4, ok) ||
+      !hpp_check<long>    ("zz", 2, 36, 1295, 2, ok) ||
+      !hpp_check<short>   ("xyz", 3, 10, 0, 0, inval) ||
+      !hpp_check<unsigned>("7", 1, 40, 0, 0, inval) ||
+      !hpp_check<double>  ("1.5e3", 5, 10, 1500.0, 5, ok) ||
+      !hpp_check<double>  ("1.5e3", 3, 10, 1.5, 3, ok) ||
+      !hpp_check<float>   ("0.25", 4, 10, 0.25f, 4, ok) ||
+      !hpp_check<long double>("-0x1p4", 6, 0, -16.0L, 6, ok) ||
+      !hpp_check<double>  ("-", 1, 10, 0.0, 0, inval))
+      return (0);
+
+   {
+      int16_t v = 0;
+      if((s2n::from_chars<16>("7fff", "7fff" + 4, v).ec != ok) || (v != 0x7fff) ||
+         (s2n::from_chars<16>("8000", "8000" + 4, v).ec != range))
+      {
+         sfprintf(stderr, "Unexpected result of s2n::from_chars<16>()!\n");
+         return (0);
+      }
+   }
+
+   /* long ranges */
+   if((s2n::from_chars(big, d).ec != ok) || (d != 12.5))
+   {
+      sfprintf(stderr, "Unexpected result of s2n::from_chars() for a long string!\n");
+      return (0);
+   }
+
+   return (1);
+}/* int test_hpp() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_ranges tests the view s2n::numbers of str2num.hpp
+\* ------------------------------------------------------------------------- */
+#if defined (__cpp_lib_ranges)
+
+static_assert(std::ranges::view<s2n::numbers<int64_t>> && std::ranges::forward_range<s2n::numbers<int64_t>> &&
+              std::ranges::borrowed_range<s2n::numbers<int64_t>>, "s2n::numbers isn't a borrowed forward view");
+
+/* constexpr_sum returns the sum of the numbers of a comma separated string */
+static constexpr int64_t constexpr_sum(std::string_view sv)
+{
+   int64_t sum = 0;
+
+   for(int64_t v : s2n::numbers<int64_t>(sv, ","))
+      sum += v;
+
+   return (sum);
+}/* int64_t constexpr_sum(std::string_view sv) */
+
+static int test_ranges()
+{
+   const char *          ps     = " 12,-5,x,,7 ,99999999999999999999,0x1f";
+   s2n::numbers<int64_t> nums(ps, ",", 0);
+   int64_t               sum    = 0;
+   size_t                count  = 0;
+   size_t                errors = 0;
+   std::string_view      third;
+
+   static_assert(constexpr_sum("1, 2,3 ,40,") == 46, "constexpr_sum");
+
+   for(auto it = nums.begin(); it != nums.end(); ++it, ++count)
+   {
+      if(count == 2)
+         third = it.text();
+
+      if(it.error() != std::errc())
+         ++errors;
+      else
+         sum += *it;
+   }
+
+   if((sum != 45) || (count != 7) || (errors != 3) || (third != "x"))
+   {
+      sfprintf(stderr, "Unexpected results of s2n::numbers(\"%s\") (sum=%lld, count=%u, errors=%u)!\n",
+               ps, (long long) sum, (unsigned) count, (unsigned) errors);
+      return (0);
+   }
+
+   /* composition with the views of the standard library */
+   sum = 0;
+   for(int v : s2n::numbers<int>("1;2;3;4;5;6", ";") | std::views::filter([](int v) { return ((v & 1) == 0); })
+                                                     | std::views::transform([](int v) { return (v * 10); })
+                                                     | std::views::take(2))
+      sum += v;
+
+   if(sum != 60)
+   {
+      sfprintf(stderr, "Unexpected result of s2n::numbers with std::views (%lld != 60)!\n", (long long) sum);
+      return (0);
+   }
+
+   {
+      s2n::numbers<double> flt("1.5::-2.25:: 1e3", "::");
+      double               d = 0.0;
+
+      for(double v : flt)
+         d += v;
+
+      if((d != 999.25) || (std::ranges::distance(flt) != 3) || (std::ranges::distance(s2n::numbers<int>("1,2,", ",")) != 2) ||
+         !std::ranges::empty(s2n::numbers<int>("", ",")) || (*std::ranges::max_element(s2n::numbers<uint8_t>("7 9 3", " ")) != 9))
+      {
+         sfprintf(stderr, "Unexpected results of s2n::numbers for floating point numbers or special buffers!\n");
+         return (0);
+      }
+   }
+
+   {  /* the result of operator * must outlive the iterator */
+      const auto & m = *std::ranges::max_element(s2n::numbers<long long>("7,900000,3", ","));
+
+      if(m != 900000)
+      {
+         sfprintf(stderr, "Unexpected maximum of s2n::numbers (%lld != 900000)!\n", m);
+         return (0);
+      }
+   }
+
+   return (1);
+}/* int test_ranges() */
+
+#else
+
+static int test_ranges()
+{
+   return (1); /* requires C++20 */
+}/* int test_ranges() */
+
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   test_coro tests the coroutine s2n::number_parser of str2num_coro.hpp
+\* ------------------------------------------------------------------------- */
+#if defined (__cpp_impl_coroutine) && defined (__cpp_lib_ranges)
+
+/* coro_check parses a string that is split at pos and compares the results with s2n::numbers */
+template <typename T>
+static int coro_check(std::string_view sv, size_t pos, int base)
+{
+   s2n::number_parser<T> parser(',', base);
+   s2n::numbers<T>       nums(sv, ",", base);
+   auto                  it = nums.begin();
+   T                     v  = T(0);
+   std::errc             ec = std::errc();
+   size_t                n  = 0;
+   std::string_view      part[2] = { sv.substr(0, pos), sv.substr(pos) };
+
+   for(int i = 0; i < 3; ++i)
+   {
+      if(!((i < 2) ? parser.feed(part[i]) : parser.finish()))
+         return (0);
+
+      while(parser.next(v, ec))
+      {
+         if((it == nums.end()) || (v != *it) || (ec != it.error()))
+         {
+            sfprintf(stderr, "Unexpected field %u of s2n::number_parser(\"%.*s\" | \"%.*s\")!\n", (unsigned) n,
+                     (int) part[0].size(), part[0].data(), (int) part[1].size(), part[1].data());
+            return (0);
+         }
+         ++it;
+         ++n;
+      }
+   }
+
+   return (parser.done() && (it == nums.end()));
+}/* int coro_check(std::string_view sv, size_t pos, int base) */
+
+static int test_coro()
+{
+   const char *                 pi = " 7, -12 ,0x1f,abc,,18446744073709551615,42,";
+   const char *                 pd = "1.5e3,-0.25 , 1e-5,x,0x1p4";
+   std::string                  big(300, '1');
+   s2n::number_parser<uint64_t> parser;
+   uint64_t                     v  = 0;
+   std::errc                    ec = std::errc();
+   size_t                       i;
+
+   for(i = 0; i <= strlen(pi); ++i)
+   {
+      if(!coro_check<int64_t>(pi, i, 0) || !coro_check<uint8_t>(pi, i, 10))
+         return (0);
+   }
+
+   for(i = 0; i <= strlen(pd); ++i)
+   {
+      if(!coro_check<double>(pd, i, 0) || !coro_check<float>(pd, i, 10))
+         return (0);
+   }
+
+   /* a split field that doesn't fit into the coroutine frame */
+   if(!parser.feed("5,") || !parser.next(v, ec) || (v != 5) || parser.next(v, ec) || !parser.feed(big) ||
+      parser.feed("1") || parser.next(v, ec) || !parser.feed(big) || parser.next(v, ec) || !parser.finish() ||
+      !parser.next(v, ec) || (ec != std::errc::value_too_large) || parser.next(v, ec) || !parser.done())
+   {
+      sfprintf(stderr, "s2n::number_parser doesn't detect split fields that are too long!\n");
+      return (0);
+   }
+
+   return (1);
+}/* int test_coro() */
+
+#else
+
+static int test_coro()
+{
+   return (1); /* requires C++20 */
+}/* int test_coro() */
+
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   fc_usage prints the command line options
+\* ------------------------------------------------------------------------- */
+static void fc_usage(const char * pname)
+{
+   sfprintf(stderr,
+            "usage: %s [options]\n"
+            "  -f list   compare only the comma separated str2num functions (a trailing * matches prefixes)\n"
+            "  -c list   compare only the comma separated input classes\n"
+            "  -d file   compare the numbers of a file with one number per line (repeatable)\n"
+            "  -B base   numeric base of the numbers of the files (default 10)\n"
+            "  -o file   write the results into a JSON file or a CSV file if the name ends with .csv\n"
+            "  -n count  number of strings of each input (default 10000)\n"
+            "  -t count  number of timed trials (default 31)\n"
+            "  -w count  number of warmup runs (default 5)\n"
+            "  -l        list the functions and input classes\n",
+            pname);
+}/* void fc_usage(const char * pname) */
+
+
+/* ------------------------------------------------------------------------- *\
+   main function
+\* ------------------------------------------------------------------------- */
+int main(int argc, char * argv[])
+{
+    BENCH_OPT opt;
+    size_t    i;
+    int       a;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.count  = 10000;
+    opt.trials = 31;
+    opt.warmup = 5;
+    opt.base   = 10;
+
+    for(a = 1; a < argc; ++a)
+    {
+        const char * popt = argv[a];
+        const char * parg = (a + 1 < argc) ? argv[a + 1] : NULL;
+
+        if(!strcmp(popt, "-l"))
+        {
+            sfprintf(stdout, "functions:\n");
+            for(i = 0; i < ARRAY_SIZE(fc_pairs); ++i)
+                sfprintf(stdout, "   %-14s %s\n", fc_pairs[i].name, fc_pairs[i].fc_name);
+
+            sfprintf(stdout, "input classes:\n");
+            for(i = 0; i < ARRAY_SIZE(bench_classes); ++i)
+                sfprintf(stdout, "   %-14s %s (base %d)\n", bench_classes[i].name, bench_classes[i].desc, bench_classes[i].base);
+            return (0);
+        }
+        else if(parg && !strcmp(popt, "-f"))
+            opt.pfuncs = argv[++a];
+        else if(parg && !strcmp(popt, "-c"))
+            opt.pclasses = argv[++a];
+        else if(parg && !strcmp(popt, "-d") && (opt.files < BENCH_MAX_FILES))
+            opt.pfile[opt.files++] = argv[++a];
+        else if(parg && !strcmp(popt, "-B"))
+            opt.base = str2i32(argv[++a], NULL, 10);
+        else if(parg && !strcmp(popt, "-o"))
+            opt.pout = argv[++a];
+        else if(parg && !strcmp(popt, "-n"))
+            opt.count = (size_t) str2sz(argv[++a], NULL, 10);
+        else if(parg && !strcmp(popt, "-t"))
+            opt.trials = str2i32(argv[++a], NULL, 10);
+        else if(parg && !strcmp(popt, "-w"))
+            opt.warmup = str2i32(argv[++a], NULL, 10);
+        else
+        {
+            fc_usage(argv[0]);
+            return (2);
+        }
+    }
+
+    if(!opt.count || (opt.trials < 1) || (opt.warmup < 0) || (opt.base < 0) || (opt.base == 1) || (opt.base > 36))
+    {
+        fc_usage(argv[0]);
+        return (2);
+    }
+
+    if(!test_native() || !test_native_float() || !test_constexpr() || !test_hpp() || !test_ranges() || !test_coro())
+    {
+        sfprintf(stderr, "Tests failed!\n");
+        return (1);
+    }
+
+    sfprintf(stdout, "%-10s %-14s %-15s %9s %9s %8s %8s %8s %8s %8s\n", "input", "function", "from_chars",
+             "ns/value", "ns/value", "ratio", "values", "ends", "errors", "max ulp");
+
+    for(i = 0; i < (size_t) opt.files; ++i)
+    {
+        BENCH_INPUT in;
+        int         ok;
+
+        if(!input_load(&in, opt.pfile[i], opt.base))
+            return (1);
+
+        ok = fc_input(&in, &opt);
+        input_free(&in);
+
+        if(!ok)
+            return (1);
+    }
+
+    for(i = 0; i < ARRAY_SIZE(bench_classes); ++i)
+    {
+        BENCH_INPUT in;
+        int         ok;
+
+        if((opt.files && !opt.pclasses) || !name_selected(opt.pclasses, bench_classes[i].name))
+            continue;
+
+        if(!input_generate(&in, &bench_classes[i], opt.count))
+            return (1);
+
+        ok = fc_input(&in, &opt);
+        input_free(&in);
+
+        if(!ok)
+            return (1);
+    }
+
+    if(opt.pout && !write_results(opt.pout, &opt))
+        return (1);
+
+    return (0);
+}/* main() */
+
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -1,7 +1,9 @@
 #if 0
-rm -f ./_bench_str2num
-cc -Wall -O3 -o _bench_str2num -I . -I ../callback_printf ../callback_printf/callback_printf.c  ../callback_printf/sfprintf.c bench_str2num.c str2num.c
-./_bench_str2num
+rm -f ./_bench_str2num ./_bench_str2num_inline ./_bench_str2num.json
+cc -Wall -O3 -DBENCH_CFLAGS='"-Wall -O3"' -o _bench_str2num -I . -I ../callback_printf ../callback_printf/callback_printf.c  ../callback_printf/sfprintf.c bench_str2num.c str2num.c str2num_batch.c str2num_file.c -lpthread
+cc -Wall -O3 -DS2N_HEADER_ONLY=1 -DBENCH_CFLAGS='"-Wall -O3 -DS2N_HEADER_ONLY=1"' -o _bench_str2num_inline -I . -I ../callback_printf ../callback_printf/callback_printf.c  ../callback_printf/sfprintf.c bench_str2num.c str2num_batch.c str2num_file.c -lpthread
+./_bench_str2num -o _bench_str2num.json || exit $?
+./_bench_str2num_inline -C _bench_str2num.json
 exit $?
 #endif
 
@@ -95,78 +97,92 @@ exit $?
 #define strtoull    _strtoui64
 #endif
 
+#include <sys/utime.h>
 #else
 #include <sys/time.h>
+#include <utime.h>
 #endif
+#include <time.h>
 #include <inttypes.h>
+#if defined (_WIN32)
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
 
 #define PRINTF_LIKE_ARGS(fmtidx, argidx)
 #include <sfprintf.h>
 #include <str2num.h>
+#include <str2num_batch.h>
+#include <str2num_file.h>
 
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
 #endif
 
-#if defined (_WIN32) || defined (__CYGWIN__)
+#if defined (__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAVE_PERF 1
+#else
+#define HAVE_PERF 0
+#endif
 
-static void (WINAPI * vGetSystemTimePreciseAsFileTime)(LPFILETIME lpSystemTimeAsFileTime);
-static HMODULE hmKernel32Dll = (HMODULE) -1;
+#if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+#include <intrin.h>
+#define HAVE_TSC 1
+#elif (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
 
 /* ------------------------------------------------------------------------- *\
-   unix_time returns the Unix time in microsecond (time since 01/01/1970)
+   bench_ns returns a monotonic time stamp in nanoseconds
 \* ------------------------------------------------------------------------- */
-int64_t TimeStamp()
+uint64_t bench_ns()
 {
-   int64_t iRet;
-   FILETIME CurrentTime;
-
-   if(vGetSystemTimePreciseAsFileTime)
-   {
-      vGetSystemTimePreciseAsFileTime(&CurrentTime);
-   }
-   else if(hmKernel32Dll == (HMODULE) -1)
-   { /* 1rst call */
-      hmKernel32Dll = LoadLibrary("Kernel32.dll");
-      if(hmKernel32Dll)
-         vGetSystemTimePreciseAsFileTime = (void (WINAPI * )(LPFILETIME)) GetProcAddress(hmKernel32Dll, "GetSystemTimePreciseAsFileTime");
+#if defined (_WIN32) || defined (__CYGWIN__)
+   static double dScale = 0.0;
+   LARGE_INTEGER li;
 
-      if(vGetSystemTimePreciseAsFileTime)
-         vGetSystemTimePreciseAsFileTime(&CurrentTime);
-      else
-         GetSystemTimeAsFileTime(&CurrentTime);
-   }
-   else
+   if(dScale == 0.0)
    {
-      GetSystemTimeAsFileTime(&CurrentTime);
+      QueryPerformanceFrequency(&li);
+      dScale = 1e9 / (double) li.QuadPart;
    }
 
-   iRet  = ((int64_t) CurrentTime.dwHighDateTime << 32);
-   iRet += (int64_t)  CurrentTime.dwLowDateTime;
-   iRet -= (int64_t)  116444736 * 1000000 * 1000; /* offset of Windows FileTime to start of Unix time */
-   return (iRet / 10);
-}/* int64_t TimeStamp() */
-
+   QueryPerformanceCounter(&li);
+   return ((uint64_t) ((double) li.QuadPart * dScale));
 #else
+   struct timespec ts;
 
-int64_t TimeStamp()
-{
-   int64_t tRet;
-   struct timeval tv;
-
-   gettimeofday(&tv, NULL);
-
-   tRet = (int64_t) tv.tv_sec;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec);
+#endif
+}/* uint64_t bench_ns() */
 
-   /* Try to turn the year 2038 problem into a year 2106 problem. */
-   if((sizeof(time_t) <= 4) && (tv.tv_sec < 0))
-      tRet += (int64_t) 0x80000000ul + (int64_t) 0x80000000ul;
 
-   tRet *= 1000000ul;
-   tRet += tv.tv_usec;
-   return (tRet);
-}/* int64_t TimeStamp() */
+/* ------------------------------------------------------------------------- *\
+   bench_cycles returns the time stamp counter of the CPU or 0 if there is
+   none. The counter runs at the nominal frequency of the CPU on all recent
+   x86 systems and not with the current core clock.
+\* ------------------------------------------------------------------------- */
+uint64_t bench_cycles()
+{
+#if HAVE_TSC
+   return ((uint64_t) __rdtsc());
+#else
+   return (0);
 #endif
+}/* uint64_t bench_cycles() */
+
+/* BENCH_SUITE_ONLY leaves out the tests and main() for programs like bench_from_chars.cpp
+   that include this file for the benchmark suite only. */
+#ifndef BENCH_SUITE_ONLY
 
 typedef struct STRING_VALUE_S STRING_VALUE;
 struct STRING_VALUE_S
@@ -180,10 +196,12 @@ int test_base_detection()
 {
    int iRet = 0;
    STRING_VALUE   TestData0[] = {{ " 123", 10,  123}, {  "0123",  8,  0123}, {  "0o123", 8,  0123}, { " 0b1123", 2,  3},  {"0x123", 16,  0x123},
-                                 {" -123", 10, -123}, {"-01239",  8, -0123}, {"-0o1239", 8, -0123}, {" -0b1123", 2, -3}, {"-0x123", 16, -0x123}};
+                                 {" -123", 10, -123}, {"-01239",  8, -0123}, {"-0o1239", 8, -0123}, {" -0b1123", 2, -3}, {"-0x123", 16, -0x123},
+                                 {"0o723", 8,  0723}, {"-0o7239", 8, -0723}};
 
    STRING_VALUE   TestData1[] = {{ " 123", 10,  123}, {  "0123", 10,   123}, {  "0o123", 8,  0123}, {  "0b1123", 2,  3},  {"0x123", 16,  0x123},
-                                 {" -123", 10, -123}, {"-01239", 10, -1239}, {"-0o1239", 8, -0123}, {" -0b1123", 2, -3}, {"-0x123", 16, -0x123}};
+                                 {" -123", 10, -123}, {"-01239", 10, -1239}, {"-0o1239", 8, -0123}, {" -0b1123", 2, -3}, {"-0x123", 16, -0x123},
+                                 {"0o723", 8,  0723}, {"-0o7239", 8, -0723}};
 
    size_t         count  = ARRAY_SIZE(TestData0);
    STRING_VALUE * pSV = TestData0;
@@ -296,8 +314,6 @@ int run_tests()
 {
    int iRet = 0;
 
-   time_t t0 = TimeStamp();
-   time_t t1 = TimeStamp();
    int64_t i;
    long ol;
    long nl;
@@ -311,34 +327,6 @@ int run_tests()
    char * pr;
    const char * ps = " -2134567890-2 ";
 
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nl = str2l_r(ps + (i&7), NULL, 0, NULL);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ___ str2l_r() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nl = str2l(ps + (i&7), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average _____ str2l() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      ol = strtol(ps + (i&7), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ____ strtol() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      ol = atol(ps + (i&7));
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ______ atol() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
    i  = 100000;
    while (i--)
    {
@@ -360,27 +348,6 @@ int run_tests()
    }
 
    ps = " -12345678901234567890  -54321 ";
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nll = str2ll_r(ps + (i&15), NULL, 0, NULL);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average __ str2ll_r() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nll = str2ll(ps + (i&15), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ____ str2ll() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      oll = strtoll(ps + (i&15), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ___ strtoll() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
    i  = 100000;
    while (i--)
    {
@@ -402,27 +369,6 @@ int run_tests()
    }
 
    ps = " 1234567890 -2 ";
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nlu = str2ul_r(ps + (i&7), NULL, 0, NULL);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average __ str2ul_r() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nlu = str2ul(ps + (i&7), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ____ str2ul() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      olu = strtoul(ps + (i&7), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ___ strtoul() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
    i  = 100000;
    while (i--)
    {
@@ -444,27 +390,6 @@ int run_tests()
 
    ps = "  12345678901234567890  -54321 ";
 
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nllu = str2ull_r(ps + (i&15), NULL, 0, NULL);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average _ str2ull_r() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      nllu = str2ull(ps + (i&15), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ___ str2ull() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      ollu = strtoull(ps + (i&15), NULL, 0);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average __ strtoull() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
    i  = 100000;
    while (i--)
    {
@@ -642,12 +567,719 @@ int test_str2value()
    return (bRet);
 } /* int test_str2value */
 
+int test_batch()
+{
+   int    iRet = 0;
+   char * pbuf = NULL;
+   size_t len  = 0;
+   size_t i;
+   s2n_agg_i64 ai0;
+   s2n_agg_i64 ai1;
+   s2n_agg_u64 au;
+   s2n_agg_d   ad0;
+   s2n_agg_d   ad1;
+   s2n_sel     sel;
+   size_t      rows[16];
+   uint8_t     bits[2];
+   s2n_col     col;
+   s2n_ctx     ctx;
+   int64_t     isum;
+   double      dsum;
+   struct ArrowArray  array;
+   struct ArrowSchema schema;
+   const char * ps = " 12, -5 ,x,, 7\r\n,0x1f,12a,  ";
+
+   if(str2agg_i64(ps, strlen(ps), ',', 0, &ai0) || (ai0.sum != 45) || (ai0.min != -5) || (ai0.max != 31) ||
+      (ai0.count != 4) || (ai0.errors != 4) || ai0.overflow)
+   {
+      sfprintf(stderr, "Unexpected aggregates of str2agg_i64(\"%s\") (sum=%lld, min=%lld, max=%lld, count=%u, errors=%u)!\n",
+               ps, (long long) ai0.sum, (long long) ai0.min, (long long) ai0.max, (unsigned) ai0.count, (unsigned) ai0.errors);
+      goto Exit;
+   }
+
+   ps = "18446744073709551615;1;";
+   if(str2agg_u64(ps, strlen(ps), ';', 10, &au) || (au.count != 2) || !au.overflow || (au.max != UINT64_MAX) || (au.min != 1))
+   {
+      sfprintf(stderr, "Unexpected aggregates of str2agg_u64(\"%s\")!\n", ps);
+      goto Exit;
+   }
+
+   if(str2agg_i64(ps, strlen(ps), 'e', 10, &ai0) != EINVAL)
+   {
+      sfprintf(stderr, "str2agg_i64() accepts a delimiter that is part of numbers!\n");
+      goto Exit;
+   }
+
+   ps = "5,-12,0,123,x,-0,99,100,007,-99999999999999999999,+42,";
+   sel.prow  = rows;
+   sel.pbits = bits;
+   sel.size  = ARRAY_SIZE(rows);
+
+   if((str2rows(ps, strlen(ps), ',') != 11) || str2sel_i64(ps, strlen(ps), ',', 10, -12, 99, &sel) ||
+      (sel.rows != 11) || (sel.matches != 7) || (sel.errors != 2) || (bits[0] != 0x67) || (bits[1] != 0x05) ||
+      (rows[0] != 0) || (rows[3] != 5) || (rows[6] != 10))
+   {
+      sfprintf(stderr, "Unexpected selection of str2sel_i64(\"%s\") (rows=%u, matches=%u, errors=%u)!\n",
+               ps, (unsigned) sel.rows, (unsigned) sel.matches, (unsigned) sel.errors);
+      goto Exit;
+   }
+
+   sel.size = 3;
+   if((str2sel_u64(ps, strlen(ps), ',', 10, 0, 99, &sel) != ENOBUFS) || (sel.rows != 3))
+   {
+      sfprintf(stderr, "str2sel_u64() doesn't care about the size of the selection!\n");
+      goto Exit;
+   }
+
+   ps = "1,NA,-3,300,,x,-128|127";
+   if(str2col_init(&col, S2N_COL_I8, 10, 0, NULL) || str2col_append(&col, ps, 18, ',') ||
+      str2col_append(&col, ps + 18, strlen(ps) - 18, '|') || (col.length != 9) || (col.null_count != 4) ||
+      (col.errors != 2) || (col.pvalidity[0] != 0xc5) || (col.pvalidity[1] != 0x01) ||
+      (((int8_t *) col.pvalues)[2] != -3) || (((int8_t *) col.pvalues)[3] != 0) || (((int8_t *) col.pvalues)[8] != 127) ||
+      ((uintptr_t) col.pvalues & 63) || ((uintptr_t) col.pvalidity & 63))
+   {
+      sfprintf(stderr, "Unexpected column of str2col_append(\"%s\") (length=%u, nulls=%u, errors=%u)!\n",
+               ps, (unsigned) col.length, (unsigned) col.null_count, (unsigned) col.errors);
+      str2col_free(&col);
+      goto Exit;
+   }
+
+   if(str2col_export(&col, "i8", &array, &schema) || (array.length != 9) || (array.null_count != 4) ||
+      (array.n_buffers != 2) || !array.buffers[0] || strcmp(schema.format, "c") || strcmp(schema.name, "i8") ||
+      (col.length != 0) || col.pvalues)
+   {
+      sfprintf(stderr, "Unexpected Arrow array of str2col_export()!\n");
+      str2col_free(&col);
+      goto Exit;
+   }
+
+   array.release(&array);
+   schema.release(&schema);
+
+   if(array.release || schema.release)
+   {
+      sfprintf(stderr, "Release callbacks of str2col_export() don't mark the structures as released!\n");
+      goto Exit;
+   }
+
+   str2col_init(&col, S2N_COL_F64, 10, 0, NULL);
+   for(i = 0; i < 1000; ++i)
+   {
+      if(str2col_append(&col, "0.5;-1e3;null", 13, ';'))
+         break;
+   }
+
+   if((col.length != 3000) || (col.null_count != 1000) || col.errors || (((double *) col.pvalues)[2997] != 0.5) ||
+      (((double *) col.pvalues)[2998] != -1000.0) || (col.pvalidity[374] != 0x6d))
+   {
+      sfprintf(stderr, "Unexpected column of str2col_append() for floating point numbers (length=%u, nulls=%u)!\n",
+               (unsigned) col.length, (unsigned) col.null_count);
+      str2col_free(&col);
+      goto Exit;
+   }
+   str2col_free(&col);
+
+   ps = " 1,234 ;-5;NA;12x;99999999999999999999;7";
+   if(s2n_ctx_init(&ctx, 10, 0, '.', ',', NULL))
+   {
+      sfprintf(stderr, "s2n_ctx_init() fails for valid options!\n");
+      goto Exit;
+   }
+
+   isum  = s2n_ctx_i64(&ctx, ps, 7);
+   isum += s2n_ctx_i64(&ctx, ps + 8, 2);
+   isum += s2n_ctx_i64(&ctx, ps + 11, 2);
+   isum += s2n_ctx_i64(&ctx, ps + 14, 3);
+   isum += s2n_ctx_i64(&ctx, ps + 18, 20);
+   isum += s2n_ctx_i64(&ctx, ps + 39, 1);
+
+   if((isum != 1236) || (ctx.count != 3) || (ctx.nulls != 1) || (ctx.errors != 2) ||
+      (ctx.perror != ps + 14) || (ctx.error != EINVAL))
+   {
+      sfprintf(stderr, "Unexpected results of s2n_ctx_i64(\"%s\") (sum=%lld, count=%u, nulls=%u, errors=%u)!\n",
+               ps, (long long) isum, (unsigned) ctx.count, (unsigned) ctx.nulls, (unsigned) ctx.errors);
+      goto Exit;
+   }
+
+   s2n_ctx_clear(&ctx);
+   pbuf = (char *) malloc(2); /* a field at the very end of a heap block */
+   if(!pbuf)
+      goto Exit;
+   memcpy(pbuf, "12", 2);
+
+   if(ctx.errors || ctx.perror || (s2n_ctx_i64(&ctx, pbuf, 2) != 12) || (s2n_ctx_d(&ctx, pbuf, 1) != 1.0) ||
+      (s2n_ctx_i64(&ctx, "1234", 2) != 12) || ctx.errors)
+   {
+      sfprintf(stderr, "s2n_ctx_i64() reads beyond the end of a field!\n");
+      goto Exit;
+   }
+   free(pbuf);
+   pbuf = NULL;
+
+   if(s2n_ctx_init(&ctx, 16, S2N_CTX_SATURATE | S2N_CTX_PARTIAL, '.', 0, NULL) ||
+      (s2n_ctx_i64(&ctx, ps + 18, 20) != INT64_MAX) || (s2n_ctx_i64(&ctx, ps + 14, 3) != 0x12) ||
+      (s2n_ctx_u64(&ctx, "ff;", 2) != 255) || ctx.errors || (ctx.count != 3))
+   {
+      sfprintf(stderr, "Unexpected results of s2n_ctx_i64() with S2N_CTX_SATURATE | S2N_CTX_PARTIAL!\n");
+      goto Exit;
+   }
+
+   if(s2n_ctx_init(&ctx, 10, S2N_CTX_STRICT, '.', 0, NULL) || (s2n_ctx_i64(&ctx, ps + 8, 3) != 0) ||
+      (s2n_ctx_i64(&ctx, " 5", 2) != 0) || (ctx.errors != 2) || (ctx.error != EINVAL))
+   {
+      sfprintf(stderr, "s2n_ctx_i64() with S2N_CTX_STRICT accepts blanks!\n");
+      goto Exit;
+   }
+
+   ps   = "1.234,5|-0,25|1,5,0|1e3";
+   dsum = 0;
+   if(!s2n_ctx_init(&ctx, 10, 0, ',', '.', NULL))
+   {
+      dsum  = s2n_ctx_d(&ctx, ps, 7);
+      dsum += s2n_ctx_d(&ctx, ps + 8, 5);
+      dsum += s2n_ctx_d(&ctx, ps + 14, 5);
+      dsum += s2n_ctx_d(&ctx, ps + 20, 3);
+   }
+
+   if((dsum != 2234.25) || (ctx.count != 3) || (ctx.errors != 1) || (ctx.perror != ps + 14))
+   {
+      sfprintf(stderr, "Unexpected results of s2n_ctx_d(\"%s\") (sum=%f, count=%u, errors=%u)!\n",
+               ps, dsum, (unsigned) ctx.count, (unsigned) ctx.errors);
+      goto Exit;
+   }
+
+   if((s2n_ctx_init(&ctx, 10, 0, 'e', 0, NULL) != EINVAL) || (s2n_ctx_init(&ctx, 10, 0, ',', ',', NULL) != EINVAL) ||
+      (s2n_ctx_init(&ctx, 37, 0, '.', 0, NULL) != EINVAL))
+   {
+      sfprintf(stderr, "s2n_ctx_init() accepts invalid options!\n");
+      goto Exit;
+   }
+
+   pbuf = (char *) malloc(1000000 * 16);
+   if(!pbuf)
+      goto Exit;
+
+   for(i = 0; i < 1000000; ++i)
+   {
+      if((i % 997) == 3)
+         len += ssprintf(pbuf + len, "-x\n");
+      else
+         len += ssprintf(pbuf + len, "%.3f\n", (double) ((long) (i * 7919 % 200003) - 100000) / 8);
+   }
+
+   if(str2agg_i64(pbuf, len, '\n', 10, &ai0) || str2agg_i64_mt(pbuf, len, '\n', 10, 7, &ai1) ||
+      (ai0.count != 0) || (ai1.count != 0) || (ai0.errors != 1000000) || (ai1.errors != 1000000))
+   {
+      sfprintf(stderr, "Unexpected results of str2agg_i64() for a buffer of floating point numbers!\n");
+      goto Exit;
+   }
+
+   if(str2agg_d(pbuf, len, '\n', 10, &ad0) || str2agg_d_mt(pbuf, len, '\n', 10, 0, &ad1) ||
+      (ad0.count != ad1.count) || (ad0.errors != ad1.errors) || (ad0.min != ad1.min) || (ad0.max != ad1.max) ||
+      (ad0.errors != 1004) || (ad0.min != -12500.0) || (ad0.max != 12500.25) ||
+      (((ad0.sum - ad1.sum) / ad0.sum) < -1e-12) || (((ad0.sum - ad1.sum) / ad0.sum) > 1e-12))
+   {
+      sfprintf(stderr, "Results of str2agg_d() and str2agg_d_mt() differ (sum %f != %f, count %u != %u, min %f != %f, max %f != %f)!\n",
+               ad0.sum, ad1.sum, (unsigned) ad0.count, (unsigned) ad1.count, ad0.min, ad1.min, ad0.max, ad1.max);
+      goto Exit;
+   }
+
+   iRet = 1;
+   Exit:;
+
+   if(pbuf)
+      free(pbuf);
+
+   return (iRet);
+} /* int test_batch() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_file tests the cache and index files of str2num_file.c
+\* ------------------------------------------------------------------------- */
+int test_file()
+{
+   int          iRet  = 0;
+   const char * psrc  = "_test_str2num.txt";
+   const char * pdata = "1.5\n-2e3\nNA\n0x10\n\n7\n";
+   FILE *       pf    = fopen(psrc, "wb");
+   s2n_cache    c;
+   s2n_index    ix;
+   int          err;
+   int64_t      i64;
+   double       d;
+   long         i;
+   struct utimbuf ut;
+
+   /* the rewrites of the same size get the same modification time */
+   ut.actime  = time(NULL);
+   ut.modtime = ut.actime;
+
+   memset(&c, 0, sizeof(c));
+   memset(&ix, 0, sizeof(ix));
+
+   if(!pf || (fwrite(pdata, 1, strlen(pdata), pf) != strlen(pdata)) || fclose(pf))
+   {
+      sfprintf(stderr, "Can't write the test file %s!\n", psrc);
+      goto Exit;
+   }
+
+   if((str2cache_open(&c, psrc, NULL, S2N_COL_F64, 0) != ENOENT) ||
+      str2cache_load(&c, psrc, NULL, S2N_COL_F64, 10, '\n', S2N_CACHE_VERIFY) ||
+      (c.type != S2N_COL_F64) || (c.count != 6) || (c.null_count != 3) || (c.errors != 1) ||
+      (((const double *) c.pvalues)[1] != -2000.0) || (((const double *) c.pvalues)[5] != 7.0) ||
+      (c.pvalidity[0] != 0x23) || ((uintptr_t) c.pvalues & 63) || ((uintptr_t) c.pvalidity & 63))
+   {
+      sfprintf(stderr, "Unexpected values of the cache file of %s (count=%u, nulls=%u, errors=%u)!\n",
+               psrc, (unsigned) c.count, (unsigned) c.null_count, (unsigned) c.errors);
+      goto Exit;
+   }
+   str2cache_close(&c);
+
+   if(str2cache_open(&c, psrc, NULL, S2N_COL_I32, 0) != EILSEQ)
+   {
+      sfprintf(stderr, "str2cache_open() accepts a cache file of another type!\n");
+      goto Exit;
+   }
+
+   pf = fopen(psrc, "ab");
+   if(!pf || (fwrite("8\n", 1, 2, pf) != 2) || fclose(pf))
+      goto Exit;
+
+   err = str2cache_open(&c, psrc, NULL, 0, 0);
+   if(err != S2N_ESTALE)
+   {
+      sfprintf(stderr, "str2cache_open() doesn't detect a changed source file (%d)!\n", err);
+      str2cache_close(&c);
+      goto Exit;
+   }
+
+   if(str2cache_load(&c, psrc, NULL, S2N_COL_I8, 0, '\n', 0) || (c.count != 7) || (c.null_count != 4) ||
+      (((const int8_t *) c.pvalues)[3] != 16) || (((const int8_t *) c.pvalues)[6] != 8))
+   {
+      sfprintf(stderr, "str2cache_load() doesn't rebuild an outdated cache file!\n");
+      goto Exit;
+   }
+   str2cache_close(&c);
+
+   /* a rewrite of the same size right after the build may keep the modification time */
+   pf = fopen(psrc, "wb");
+   if(!pf || (fwrite("1\n2\n", 1, 4, pf) != 4) || fclose(pf) || utime(psrc, &ut) ||
+      str2cache_load(&c, psrc, NULL, S2N_COL_I64, 10, '\n', 0))
+      goto Exit;
+   str2cache_close(&c);
+
+   pf = fopen(psrc, "wb");
+   if(!pf || (fwrite("7\n9\n", 1, 4, pf) != 4) || fclose(pf) || utime(psrc, &ut))
+      goto Exit;
+
+   err = str2cache_open(&c, psrc, NULL, 0, 0);
+   if((err != S2N_ESTALE) || str2cache_load(&c, psrc, NULL, S2N_COL_I64, 10, '\n', 0) ||
+      (c.count != 2) || (((const int64_t *) c.pvalues)[0] != 7))
+   {
+      sfprintf(stderr, "str2cache_open() doesn't detect a rewrite of the same size (%d)!\n", err);
+      goto Exit;
+   }
+   str2cache_close(&c);
+
+   pf = fopen(psrc, "wb");
+   if(!pf || (fwrite(pdata, 1, strlen(pdata), pf) != strlen(pdata)) || (fwrite("8\n", 1, 2, pf) != 2) || fclose(pf) || utime(psrc, &ut))
+      goto Exit;
+
+   if(str2idx_load(&ix, psrc, NULL, '\n', 0, 16) || (ix.rows != 7) || str2idx_d(&ix, 1, &d) || (d != -2000.0) ||
+      str2idx_d(&ix, 1, &d) || (d != -2000.0) || (ix.hits != 1) || str2idx_i64(&ix, 3, &i64) || (i64 != 16) || str2idx_i64(&ix, 6, &i64) || (i64 != 8) ||
+      (str2idx_i64(&ix, 1, &i64) != EINVAL) || (str2idx_d(&ix, 2, &d) != EINVAL) ||
+      (str2idx_d(&ix, 4, &d) != EINVAL) || (str2idx_d(&ix, 7, &d) != ENOENT))
+   {
+      sfprintf(stderr, "Unexpected values of the index of %s (rows=%u, hits=%u)!\n",
+               psrc, (unsigned) ix.rows, (unsigned) ix.hits);
+      goto Exit;
+   }
+   str2idx_close(&ix);
+
+   /* the row offsets of a rewrite of the same size are different */
+   pf = fopen(psrc, "wb");
+   if(!pf || (fwrite("16\n-2e3\nNA\n0x1\n\n777\n8\n", 1, 22, pf) != 22) || fclose(pf) || utime(psrc, &ut))
+      goto Exit;
+
+   err = str2idx_open(&ix, psrc, NULL, '\n', 0, 0);
+   if((err != S2N_ESTALE) || str2idx_load(&ix, psrc, NULL, '\n', 0, 0) || str2idx_i64(&ix, 3, &i64) || (i64 != 1))
+   {
+      sfprintf(stderr, "str2idx_open() doesn't detect a rewrite of the same size (%d)!\n", err);
+      goto Exit;
+   }
+   str2idx_close(&ix);
+
+   pf = fopen(psrc, "wb");
+   if(!pf)
+      goto Exit;
+
+   for(i = 0; i < 10000; ++i)
+      fprintf(pf, (i % 3) ? "%s%ld" : "%s  %ld ", i ? ";" : "", i * 37 - 5000);
+
+   if(fclose(pf))
+      goto Exit;
+
+   if(str2idx_load(&ix, psrc, "_test_str2num.idx", '\n', 10, 0) || (ix.rows != 1))
+   {
+      sfprintf(stderr, "Unexpected number of rows of the index of %s (%u)!\n", psrc, (unsigned) ix.rows);
+      goto Exit;
+   }
+   str2idx_close(&ix);
+
+   if((str2idx_open(&ix, psrc, "_test_str2num.idx", ';', 10, 0) != EILSEQ) ||
+      str2idx_load(&ix, psrc, "_test_str2num.idx", ';', 10, 0) || (ix.rows != 10000))
+   {
+      sfprintf(stderr, "Unexpected number of rows of the index of %s (%u)!\n", psrc, (unsigned) ix.rows);
+      goto Exit;
+   }
+
+   for(i = 9999; i >= 0; --i)
+   {
+      if(str2idx_i64(&ix, (size_t) i, &i64) || (i64 != i * 37 - 5000))
+      {
+         sfprintf(stderr, "Unexpected value of row %ld of the index of %s (%lld)!\n", i, psrc, (long long) i64);
+         goto Exit;
+      }
+   }
+
+   iRet = 1;
+   Exit:;
+
+   str2cache_close(&c);
+   str2idx_close(&ix);
+   remove("_test_str2num.txt.s2n");
+   remove("_test_str2num.txt.s2i");
+   remove("_test_str2num.idx");
+   remove(psrc);
+
+   return (iRet);
+} /* int test_file() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_stats tests the counters of str2num.c if compiled with S2N_STATS
+\* ------------------------------------------------------------------------- */
+int test_stats()
+{
+   s2n_stats st;
+   s2n_stats sum;
+   int       err;
+
+   str2num_stats_reset();
+
+   if(str2num_stats(&st) == ENOSYS)
+      return (1); /* str2num.c is compiled without S2N_STATS */
+
+   str2i64_r("0x1f", NULL, 0, &err);
+   str2u8_r("300", NULL, 10, &err);
+   str2i32_r("x", NULL, 40, &err);
+   str2d_r("1.5e3", NULL, 10, &err);
+   str2d_r("1e-400", NULL, 10, &err);
+   str2d_r("0.12345678901234567890123", NULL, 10, &err);
+   str2ld_r("-inf", NULL, 0, &err);
+   str2d("nan", NULL);
+
+   str2num_stats(&st);
+
+   if((st.calls[S2N_STAT_I64][0] != 1) || (st.calls[S2N_STAT_U8][10] != 1) || (st.calls[S2N_STAT_I32][37] != 1) ||
+      (st.calls[S2N_STAT_D][10] != 3) || (st.calls[S2N_STAT_D][0] != 1) || (st.calls[S2N_STAT_LD][0] != 1) ||
+      (st.pow10 + st.powi != 3) || !st.split || !st.truncated || (st.prefix != 1) ||
+      (st.inf != 1) || (st.nan != 1) || (st.range != 1) || (st.invalid != 1))
+   {
+      sfprintf(stderr, "Unexpected counters of str2num_stats() (pow10=%u, powi=%u, split=%u, truncated=%u, prefix=%u, inf=%u, nan=%u, range=%u, invalid=%u)!\n",
+               (unsigned) st.pow10, (unsigned) st.powi, (unsigned) st.split, (unsigned) st.truncated, (unsigned) st.prefix,
+               (unsigned) st.inf, (unsigned) st.nan, (unsigned) st.range, (unsigned) st.invalid);
+      return (0);
+   }
+
+   memset(&sum, 0, sizeof(sum));
+   str2num_stats_add(&sum, &st);
+   str2num_stats_add(&sum, &st);
+   str2num_stats_reset();
+   str2num_stats(&st);
+
+   if((sum.calls[S2N_STAT_D][10] != 6) || (sum.invalid != 2) || st.calls[S2N_STAT_D][10] || st.pow10)
+   {
+      sfprintf(stderr, "Unexpected counters after str2num_stats_add() or str2num_stats_reset()!\n");
+      return (0);
+   }
+
+   return (1);
+} /* int test_stats() */
+
+/* ------------------------------------------------------------------------- *\
+   test_ret compares the *_ret functions with the *_r functions
+\* ------------------------------------------------------------------------- */
+
+#define TEST_RET(fn_ret, fn_r)                                                              \
+   {                                                                                        \
+      char * pe  = NULL;                                                                    \
+      int    err = 0;                                                                       \
+      long double v = (long double) fn_r(ps, &pe, base, &err);                              \
+      if(((long double) fn_ret(ps, base).value != v) || (fn_ret(ps, base).err != err) ||    \
+         (ps + fn_ret(ps, base).len != pe))                                                 \
+      {                                                                                     \
+         sfprintf(stderr, "Different results of " #fn_ret " and " #fn_r " for \"%s\" and base %d!\n", ps, base); \
+         return (0);                                                                        \
+      }                                                                                     \
+   }
+
+int test_ret()
+{
+   static const char * const strings[] = { "0", " -12x", "0x7f", "300", "-129", "65536", "2147483648", "-9223372036854775809",
+                                           "18446744073709551616", "zz", "", "+", "1.5e3", "-0x1p-2", "inf", "1e-400" };
+   static const int bases[] = { 0, 10, 16, 36, 37 };
+   size_t i;
+   size_t b;
+
+   for(i = 0; i < ARRAY_SIZE(strings); ++i)
+   {
+      for(b = 0; b < ARRAY_SIZE(bases); ++b)
+      {
+         const char * ps   = strings[i];
+         int          base = bases[b];
+
+         TEST_RET(str2i64_ret, str2i64_r);
+         TEST_RET(str2u64_ret, str2u64_r);
+         TEST_RET(str2i32_ret, str2i32_r);
+         TEST_RET(str2u32_ret, str2u32_r);
+         TEST_RET(str2i16_ret, str2i16_r);
+         TEST_RET(str2u16_ret, str2u16_r);
+         TEST_RET(str2i8_ret,  str2i8_r);
+         TEST_RET(str2u8_ret,  str2u8_r);
+         TEST_RET(str2pd_ret,  str2pd_r);
+         TEST_RET(str2sz_ret,  str2sz_r);
+         TEST_RET(str2ip_ret,  str2ip_r);
+         TEST_RET(str2up_ret,  str2up_r);
+         TEST_RET(str2i_ret,   str2i_r);
+         TEST_RET(str2u_ret,   str2u_r);
+         TEST_RET(str2l_ret,   str2l_r);
+         TEST_RET(str2ul_ret,  str2ul_r);
+         TEST_RET(str2ll_ret,  str2ll_r);
+         TEST_RET(str2ull_ret, str2ull_r);
+         TEST_RET(str2d_ret,   str2d_r);
+         TEST_RET(str2ld_ret,  str2ld_r);
+      }
+   }
+
+   return (1);
+} /* int test_ret() */
+
+#undef TEST_RET
+
+
+/* ------------------------------------------------------------------------- *\
+   test_lazy tests the lazy number tokens of s2n_lazy_scan
+\* ------------------------------------------------------------------------- */
+int test_lazy()
+{
+   static const char * const strings[] = { "0", " -12,", "+7", "1.5e3", "-0.125", "9223372036854775807", "-9223372036854775808",
+                                           "9223372036854775808", "18446744073709551615", "18446744073709551616", "-18446744073709551616",
+                                           "1e-400", "12.34567}", "-1E+2", "007" };
+   static const char * const invalid[] = { "", "-", "1.", "1.e5", "1e", "1e+", ".5", "1~2", "0.5~", "abc" };
+   size_t   i;
+   s2n_lazy l;
+
+   for(i = 0; i < ARRAY_SIZE(strings); ++i)
+   {
+      const char * ps  = strings[i];
+      char *       pe  = NULL;
+      char *       pr  = NULL;
+      int          e0  = 0;
+      int          e1  = 0;
+      int64_t      i0  = 0;
+      int64_t      i1  = 0;
+      uint64_t     u0  = 0;
+      uint64_t     u1  = 0;
+      double       d0  = 0.0;
+      double       d1  = 0.0;
+      int          rep;
+
+      str2d_r(ps, &pr, 10, NULL);
+      if(s2n_lazy_scan(&l, ps, &pe) || (pe != pr))
+      {
+         sfprintf(stderr, "s2n_lazy_scan(\"%s\") doesn't end like str2d_r!\n", ps);
+         return (0);
+      }
+
+      for(rep = 0; rep < 2; ++rep)
+      {  /* the second access returns the cached values */
+         if(!(l.flags & S2N_LAZY_FRAC))
+         {
+            i0 = str2i64_r(ps, NULL, 10, &e0);
+            e1 = s2n_lazy_i64(&l, &i1);
+            if((i0 != i1) || (e0 != e1))
+            {
+               sfprintf(stderr, "Different results of s2n_lazy_i64 and str2i64_r for \"%s\"!\n", ps);
+               return (0);
+            }
+
+            u0 = str2u64_r(ps, NULL, 10, &e0);
+            e1 = s2n_lazy_u64(&l, &u1);
+            if((u0 != u1) || (e0 != e1))
+            {
+               sfprintf(stderr, "Different results of s2n_lazy_u64 and str2u64_r for \"%s\"!\n", ps);
+               return (0);
+            }
+         }
+         else if((s2n_lazy_i64(&l, &i1) != EINVAL) || (s2n_lazy_u64(&l, &u1) != EINVAL))
+         {
+            sfprintf(stderr, "s2n_lazy_i64 or s2n_lazy_u64 accept the floating point number \"%s\"!\n", ps);
+            return (0);
+         }
+
+         d0 = str2d_r(ps, NULL, 10, NULL);
+         if(s2n_lazy_d(&l, &d1) || (d0 != d1) || !(l.flags & S2N_LAZY_D))
+         {
+            sfprintf(stderr, "Different results of s2n_lazy_d and str2d_r for \"%s\"!\n", ps);
+            return (0);
+         }
+      }
+   }
+
+   for(i = 0; i < ARRAY_SIZE(invalid); ++i)
+   {
+      char *  pe = NULL;
+      int64_t v  = 1;
+
+      if((s2n_lazy_scan(&l, invalid[i], &pe) != EINVAL) || (pe != invalid[i]) || (s2n_lazy_i64(&l, &v) != EINVAL) || v)
+      {
+         sfprintf(stderr, "s2n_lazy_scan accepts the invalid number \"%s\"!\n", invalid[i]);
+         return (0);
+      }
+   }
+
+   {  /* NULL pointers are invalid arguments like for the *_r functions */
+      char *   pe = (char *) invalid[0];
+      int64_t  v  = 1;
+      uint64_t u  = 1;
+      double   d  = 1.0;
+
+      if((s2n_lazy_scan(NULL, "1", NULL) != EINVAL) || (s2n_lazy_scan(&l, NULL, &pe) != EINVAL) || pe ||
+         (s2n_lazy_i64(NULL, &v) != EINVAL) || v || (s2n_lazy_u64(NULL, &u) != EINVAL) || u ||
+         (s2n_lazy_d(NULL, &d) != EINVAL) || (d != 0.0) || (s2n_lazy_fix(NULL, 2, &v) != EINVAL) || v)
+      {
+         sfprintf(stderr, "The s2n_lazy_* functions accept NULL pointers!\n");
+         return (0);
+      }
+   }
+
+   {
+      static const struct { const char * ps; int scale; int64_t v; int err; } fix[] =
+      {
+         { "12.345",  2, 1234, 0 },       { "-12.345", 2, -1234, 0 },    { "12.345",  3, 12345, 0 },
+         { "1.5e3",   0, 1500, 0 },       { "1e-5",    2, 0, 0 },        { "0.05",    2, 5, 0 },
+         { "-25E-1",  1, -25, 0 },        { "7",       18, 7000000000000000000ll, 0 },
+         { "92233720368547758.08", 2, INT64_MAX, ERANGE }, { "-92233720368547758.08", 2, INT64_MIN, 0 },
+         { "1e30",    0, INT64_MAX, ERANGE }, { "0e999", 2, 0, 0 },  { "1",       19, 0, EINVAL }
+      };
+      int64_t v = 0;
+
+      for(i = 0; i < ARRAY_SIZE(fix); ++i)
+      {
+         int err = s2n_lazy_scan(&l, fix[i].ps, NULL);
+
+         if(!err)
+            err = s2n_lazy_fix(&l, fix[i].scale, &v);
+
+         if((err != fix[i].err) || (v != fix[i].v) || (s2n_lazy_fix(&l, fix[i].scale, &v) != err) || (v != fix[i].v))
+         {
+            sfprintf(stderr, "Unexpected result of s2n_lazy_fix for \"%s\" and scale %d (%lld, %d)!\n",
+                     fix[i].ps, fix[i].scale, (long long) v, err);
+            return (0);
+         }
+      }
+   }
+
+   return (1);
+} /* int test_lazy() */
+
+
+/* ------------------------------------------------------------------------- *\
+   test_any compares str2num_any with the functions of the returned type
+\* ------------------------------------------------------------------------- */
+int test_any()
+{
+   /* expected types of the bases 0, 1, 10, 16 and 36: Error, Int64, Uint64 or Double */
+   static const struct { const char * ps; const char * types; } strings[] =
+   {
+      { "0", "IIIII" }, { "-0", "IIIII" }, { " 42", "IIIII" },
+      { "+7", "IIIII" }, { "-12,", "IIIII" }, { "007", "IIIII" },
+      { "1.5", "DDDDD" }, { "-0.125", "DDDDD" }, { "1e3", "DDDII" },
+      { "1E+2", "DDDII" }, { "2e-3", "DDDII" }, { "1e", "IIIII" },
+      { "1e+", "IIIII" }, { "3~2", "DDDDD" }, { "9223372036854775807", "IIIDD" },
+      { "-9223372036854775808", "IIIDD" }, { "9223372036854775808", "UUUDD" }, { "-9223372036854775809", "DDDDD" },
+      { "18446744073709551615", "UUUDD" }, { "18446744073709551616", "DDDDD" }, { "-18446744073709551616", "DDDDD" },
+      { "123456789012345678901234", "DDDDD" }, { "12345678901234567890.5", "DDDDD" }, { "1152921504606846975", "IIIDD" },
+      { "1152921504606846976", "IIIDD" }, { "0x1F", "IIIII" }, { "-0x8000000000000000", "IIIID" },
+      { "0xFFFFFFFFFFFFFFFF", "UUIUD" }, { "0x10000000000000000", "DDIDD" }, { "0x1.8p3", "DDIDD" },
+      { "1p-2", "IIIDI" }, { "0b101", "IIIII" }, { "0o17", "IIIII" },
+      { "0x", "IIIII" }, { "zz", "EEEEI" }, { "inf", "DDDDD" },
+      { "-Infinity", "DDDDD" }, { "nan", "DDDDD" }, { "nan1", "DDDDI" },
+      { "", "EEEEE" }, { "-", "EEEEE" }, { ".5", "EEEEE" },
+      { "abc", "EEEII" }, { "1.e5", "DDDDD" }, { "1e400", "DDDII" }
+   };
+   static const int bases[] = { 0, 1, 10, 16, 36 };
+   size_t i;
+   size_t j;
+
+   for(i = 0; i < ARRAY_SIZE(strings); ++i)
+   {
+      for(j = 0; j < ARRAY_SIZE(bases); ++j)
+      {
+         const char * ps   = strings[i].ps;
+         int          base = bases[j];
+         s2n_any      r    = str2num_any(ps, base);
+         char *       pd   = NULL;
+         char *       pi   = NULL;
+         char *       pu   = NULL;
+         int          ed   = 0;
+         int          ei   = 0;
+         int          eu   = 0;
+         double       d    = str2d_r(ps, &pd, base, &ed);
+         int64_t      iv   = str2i64_r(ps, &pi, base ? base : 1, &ei);
+         uint64_t     uv   = str2u64_r(ps, &pu, base ? base : 1, &eu);
+         int          ok   = 0;
+
+         if((r.type < S2N_ANY_ERR) || (r.type > S2N_ANY_D) || ("EIUD"[r.type] != strings[i].types[j]))
+         {
+            sfprintf(stderr, "Unexpected type %d of str2num_any for \"%s\" and base %d!\n", r.type, ps, base);
+            return (0);
+         }
+
+         switch(r.type)
+         {
+            case S2N_ANY_ERR:
+               ok = (r.err == EINVAL) && !r.len && (ed == EINVAL);
+               break;
+            case S2N_ANY_I64:
+               ok = !r.err && !ei && (r.value.i64 == iv) && (pi == ps + r.len);
+               break;
+            case S2N_ANY_U64:
+               ok = !r.err && (ei == ERANGE) && !eu && (r.value.u64 == uv) && (pu == ps + r.len);
+               break;
+            case S2N_ANY_D:
+               ok = !r.err && !ed && !memcmp(&r.value.d, &d, sizeof(d)) && (pd == ps + r.len);
+               break;
+         }
+
+         if(!ok)
+         {
+            sfprintf(stderr, "Unexpected result of str2num_any for \"%s\" and base %d (type %d, %d)!\n", ps, base, r.type, r.err);
+            return (0);
+         }
+      }
+   }
+
+   return (1);
+} /* int test_any() */
+
+
 int run_float_tests()
 {
    int iret = 0;
 
-   time_t t0 = TimeStamp();
-   time_t t1 = TimeStamp();
    int64_t i;
    int e0;
    int e1;
@@ -680,21 +1312,6 @@ int run_float_tests()
       ssprintf(&buf[i][0], "%.14e", d1);
    }
 
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      d0 = str2d(buf[i&0x7f], NULL);
-
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average _____ str2d() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      d1 = strtod(buf[i&0x7f], NULL);
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ____ strtod() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
    i  = 128;
    while (i--)
    {
@@ -994,26 +1611,7 @@ int run_float_tests()
       ssprintf(&buf[i][0], "%.20Le", ld1);
    }
 
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-      ld0 = str2ld(buf[i&0x7f], NULL);
-
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ____ str2ld() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 1000000;
-   t0 = TimeStamp();
-   while (i--)
-#ifdef _WIN32
-      ld1 = strtod(buf[i&0x7f], NULL);
-#else
-      ld1 = strtold(buf[i&0x7f], NULL);
-#endif
-   t1 = TimeStamp() - t0;
-   sfprintf(stdout, "An average ___ strtold() call took %ld.%.6ld us\n", (long)(t1 / 1000000), (long)(t1 % 1000000));
-
-   i  = 128;
+   i  = 128;
    while (i--)
    {
       ps = buf[i&0x7f];
@@ -1322,41 +1920,2128 @@ int run_float_tests()
       }
    }
 
+   /* --------------------------------------------------------------------- */
+
+   /* zero with a huge exponent and fractions of mantissas of more than 64 bits */
+   d0  = str2d_r("0e999999", &pe, 10, &e0);
+   ld0 = str2ld_r("0e99999999999", &pr, 10, &e1);
+
+   if((d0 != 0.0) || e0 || *pe || (ld0 != 0.0L) || e1 || *pr)
+   {
+      sfprintf(stderr, "%d: Unexpected return value of str2d_r() or str2ld_r() for a zero! (%a, %La)\n",
+               __LINE__, d0, ld0);
+      return (iret);
+   }
+
+   ld0 = str2ld_r("50705773083579a5b85.a", &pe, 13, &e0);
+   ld1 = str2ld_r("50705773083579a5b85", NULL, 13, NULL);
+
+   if((ld0 < ld1) || (ld0 > ld1 * 1.000001L) || e0 || *pe)
+   {
+      sfprintf(stderr, "%d: Unexpected return value of str2ld_r() '50705773083579a5b85.a'! (%.32La != %.32La)\n",
+               __LINE__, ld0, ld1);
+      return (iret);
+   }
+
    iret = 1;
    return (iret);
 } /* run_float_tests() */
 
+#endif /* BENCH_SUITE_ONLY */
+
+
+/* ========================================================================= *\
+   Benchmark suite
+\* ========================================================================= */
+
+#define BK_INT   1 /* integer functions and inputs */
+#define BK_FLOAT 2 /* floating point functions and inputs */
+#define BK_ANY   3 /* functions of integers and floating point numbers */
+
+#define BENCH_MAX_LEN   64 /* maximum length of the generated strings */
+#define BENCH_MAX_FILES 16 /* maximum number of data files */
+#define BENCH_COUNTERS   4 /* number of hardware performance counters */
+
+/* state of the xorshift random number generator of the generated inputs */
+typedef struct BENCH_RNG_S BENCH_RNG;
+struct BENCH_RNG_S
+{
+   uint64_t s;
+};
+
+/* class of input strings */
+typedef struct BENCH_CLASS_S BENCH_CLASS;
+struct BENCH_CLASS_S
+{
+   const char * name;                               /* name of the class */
+   int          kind;                               /* BK_INT or BK_FLOAT */
+   int          base;                               /* numeric base of the conversions */
+   void      (* gen) (BENCH_RNG * prng, char * ps); /* generator of a single string */
+   const char * desc;                               /* description of the class */
+};
+
+/* set of input strings of a class */
+typedef struct BENCH_INPUT_S BENCH_INPUT;
+struct BENCH_INPUT_S
+{
+   const char * name;  /* name of the class */
+   int          kind;  /* BK_INT or BK_FLOAT */
+   int          base;  /* numeric base of the conversions */
+   size_t       count; /* number of strings */
+   size_t       bytes; /* number of characters of all strings */
+   char **      pps;   /* the strings */
+   char *       pbuf;  /* buffer of the strings */
+};
+
+/* loop that converts all strings of an input and returns a checksum of the values */
+typedef uint64_t (* BENCH_LOOP) (char * const * pps, size_t count, int base);
+
+/* benchmarked function */
+typedef struct BENCH_FUNC_S BENCH_FUNC;
+struct BENCH_FUNC_S
+{
+   const char * name; /* name of the function */
+   int          kind; /* BK_INT, BK_FLOAT or BK_ANY */
+   BENCH_LOOP   loop; /* conversion loop */
+};
+
+/* results of a benchmark */
+typedef struct BENCH_RESULT_S BENCH_RESULT;
+struct BENCH_RESULT_S
+{
+   double ns_median;  /* median of the nanoseconds per value of the trials */
+   double ns_p99;     /* 99th percentile of the nanoseconds per value */
+   double ns_mean;    /* mean of the nanoseconds per value */
+   double ns_stddev;  /* standard deviation of the nanoseconds per value */
+   double cyc_median; /* median of the TSC cycles per value */
+   double mb_s;       /* throughput in MB/s at the median */
+   int    trials;     /* number of trials */
+   double counter[BENCH_COUNTERS]; /* hardware events per value or -1 if not available */
+};
+
+/* options of the benchmark suite */
+typedef struct BENCH_OPT_S BENCH_OPT;
+struct BENCH_OPT_S
+{
+   const char * pfuncs;                 /* comma separated list of the function names or NULL for all */
+   const char * pclasses;               /* comma separated list of the input classes or NULL for all */
+   size_t       count;                  /* number of strings of an input */
+   int          trials;                 /* number of timed trials */
+   int          warmup;                 /* number of untimed warmup runs */
+   const char * pfile[BENCH_MAX_FILES]; /* data files with one number per line */
+   int          files;                  /* number of data files */
+   int          base;                   /* numeric base of the numbers of the data files */
+   int          perf;                   /* nonzero for reading the hardware performance counters */
+   const char * pout;                   /* JSON or CSV file for the results */
+   const char * pbaseline;              /* JSON or CSV file with the results of a previous run */
+   double       threshold;              /* minimum slowdown in percent of a regression */
+   int          threads;                /* maximum number of threads of the scaling benchmark or 0 */
+   int          latency;                /* number of single calls of the latency benchmark or 0 */
+   int          evict_mb;               /* size of the buffer for evicting the caches in MB */
+};
+
+/* keeps the compiler from removing the conversions */
+volatile uint64_t bench_sink;
+
 
 /* ------------------------------------------------------------------------- *\
-   main function
+   rng_next returns the next random value of a xorshift64* generator
 \* ------------------------------------------------------------------------- */
-int main(int argc, char * argv[])
+static uint64_t rng_next(BENCH_RNG * prng)
+{
+   prng->s ^= prng->s >> 12;
+   prng->s ^= prng->s << 25;
+   prng->s ^= prng->s >> 27;
+   return (prng->s * 0x2545F4914F6CDD1DULL);
+}/* uint64_t rng_next(BENCH_RNG * prng) */
+
+
+/* ------------------------------------------------------------------------- *\
+   rng_digits writes n random digits of a numeric base without leading zero
+\* ------------------------------------------------------------------------- */
+static char * rng_digits(BENCH_RNG * prng, char * ps, int n, int base)
 {
-    int iret = 1;
+   static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+   int i;
 
-    if(!test_base_detection())
-        goto Exit;
+   for(i = 0; i < n; ++i)
+      *ps++ = digits[(i ? 0 : 1) + rng_next(prng) % (uint64_t) (i ? base : base - 1)];
 
-    if(!test_str2value())
-        goto Exit;
+   *ps = '\0';
+   return (ps);
+}/* char * rng_digits(BENCH_RNG * prng, char * ps, int n, int base) */
 
-    if(!run_tests())
-        goto Exit;
 
-    if(!run_float_tests())
-        goto Exit;
+/* ------------------------------------------------------------------------- *\
+   generators of the input strings
+\* ------------------------------------------------------------------------- */
+static void gen_dec4(BENCH_RNG * prng, char * ps)
+{
+   if(rng_next(prng) & 1)
+      *ps++ = '-';
+   rng_digits(prng, ps, 1 + (int) (rng_next(prng) & 3), 10);
+}/* void gen_dec4(BENCH_RNG * prng, char * ps) */
 
-    iret = 0;
+static void gen_dec10(BENCH_RNG * prng, char * ps)
+{
+   *ps++ = ' ';
+   if(rng_next(prng) & 1)
+      *ps++ = '-';
+   rng_digits(prng, ps, 9, 10);
+}/* void gen_dec10(BENCH_RNG * prng, char * ps) */
 
-    Exit:;
+static void gen_dec18(BENCH_RNG * prng, char * ps)
+{
+   if(rng_next(prng) & 1)
+      *ps++ = '-';
+   rng_digits(prng, ps, 18, 10);
+}/* void gen_dec18(BENCH_RNG * prng, char * ps) */
 
-    if(!iret)
-        sfprintf(stdout, "All tests passed!\n");
-    else
-        sfprintf(stderr, "Tests failed!\n");
+static void gen_hex(BENCH_RNG * prng, char * ps)
+{
+   rng_digits(prng, ps, 1 + (int) (rng_next(prng) % 15), 16);
+}/* void gen_hex(BENCH_RNG * prng, char * ps) */
 
-    return (iret);
-}/* main() */
+static void gen_sci(BENCH_RNG * prng, char * ps)
+{
+   double d = (double) (int64_t) (1 + (rng_next(prng) >> 11)) / (double) (1 + (rng_next(prng) >> 40));
+   ssprintf(ps, "%.14e", (rng_next(prng) & 1) ? d : 1.0 / d);
+}/* void gen_sci(BENCH_RNG * prng, char * ps) */
+
+static void gen_fix(BENCH_RNG * prng, char * ps)
+{
+   ssprintf(ps, "%.2f", (double) (int64_t) (rng_next(prng) % 2000000) / 100.0 - 10000.0);
+}/* void gen_fix(BENCH_RNG * prng, char * ps) */
+
+
+static void gen_u64(BENCH_RNG * prng, char * ps)
+{
+   ssprintf(ps, "%llu", (unsigned long long) rng_next(prng));
+}/* void gen_u64(BENCH_RNG * prng, char * ps) */
+
+static void gen_zipf(BENCH_RNG * prng, char * ps)
+{
+   /* The probability of a length of n digits is proportional to 1/n. */
+   static double cdf[18];
+   double        r;
+   int           n;
+
+   if(cdf[17] == 0.0)
+   {
+      double sum = 0.0;
+
+      for(n = 0; n < 18; ++n)
+         cdf[n] = (sum += 1.0 / (n + 1));
+      for(n = 0; n < 18; ++n)
+         cdf[n] /= sum;
+   }
+
+   r = (double) (rng_next(prng) >> 11) / 9007199254740992.0;
+   for(n = 0; (n < 17) && (r >= cdf[n]); ++n)
+      ;
+
+   if(rng_next(prng) & 1)
+      *ps++ = '-';
+   rng_digits(prng, ps, n + 1, 10);
+}/* void gen_zipf(BENCH_RNG * prng, char * ps) */
+
+static void gen_id(BENCH_RNG * prng, char * ps)
+{
+   rng_digits(prng, ps, 1 + (int) (rng_next(prng) % 6), 10);
+}/* void gen_id(BENCH_RNG * prng, char * ps) */
+
+static void gen_d17(BENCH_RNG * prng, char * ps)
+{
+   double d = (double) (int64_t) (1 + (rng_next(prng) >> 11)) / (double) (1 + (rng_next(prng) >> 24));
+   ssprintf(ps, "%.17g", (rng_next(prng) & 1) ? -d : d);
+}/* void gen_d17(BENCH_RNG * prng, char * ps) */
+
+static void gen_hexfloat(BENCH_RNG * prng, char * ps)
+{
+   double d = (double) (int64_t) (1 + (rng_next(prng) >> 11)) / (double) (1 + (rng_next(prng) >> 24));
+   ssprintf(ps, "%a", (rng_next(prng) & 1) ? -d : d);
+}/* void gen_hexfloat(BENCH_RNG * prng, char * ps) */
+
+static void gen_b36(BENCH_RNG * prng, char * ps)
+{
+   rng_digits(prng, ps, 1 + (int) (rng_next(prng) % 12), 36);
+}/* void gen_b36(BENCH_RNG * prng, char * ps) */
+
+static void gen_ovf(BENCH_RNG * prng, char * ps)
+{
+   /* 20 to 24 digits with a leading digit of at least 2 overflow all integer types */
+   *ps++ = (char) ('2' + rng_next(prng) % 8);
+   rng_digits(prng, ps, 19 + (int) (rng_next(prng) % 5), 10);
+}/* void gen_ovf(BENCH_RNG * prng, char * ps) */
+
+static void gen_dovf(BENCH_RNG * prng, char * ps)
+{
+   /* exponents of 309 to 999 overflow and the negative ones underflow a double */
+   double d = (double) (int64_t) (1 + (rng_next(prng) >> 11)) / 9007199254740992.0 + 1.0;
+   ssprintf(ps, "%.15fe%c%d", d, (rng_next(prng) & 1) ? '-' : '+', 330 + (int) (rng_next(prng) % 670));
+}/* void gen_dovf(BENCH_RNG * prng, char * ps) */
+
+
+/* input classes */
+static const BENCH_CLASS bench_classes[] =
+{
+   { "dec4",     BK_INT,   10, gen_dec4,     "decimal integers of 1 to 4 digits" },
+   { "dec10",    BK_INT,   10, gen_dec10,    "decimal integers of 9 digits with a leading blank" },
+   { "dec18",    BK_INT,   10, gen_dec18,    "decimal integers of 18 digits" },
+   { "hex",      BK_INT,   16, gen_hex,      "hexadecimal integers of 1 to 15 digits without prefix" },
+   { "u64",      BK_INT,   10, gen_u64,      "uniformly distributed random uint64 values" },
+   { "zipf",     BK_INT,   10, gen_zipf,     "decimal integers with Zipf distributed lengths of 1 to 18 digits" },
+   { "id",       BK_INT,   10, gen_id,       "short IDs of 1 to 6 digits" },
+   { "b36",      BK_INT,   36, gen_b36,      "base 36 integers of 1 to 12 digits" },
+   { "sci",      BK_FLOAT, 10, gen_sci,      "doubles in %.14e format" },
+   { "fix",      BK_FLOAT, 10, gen_fix,      "fixed point numbers with 2 decimals" },
+   { "d17",      BK_FLOAT, 10, gen_d17,      "doubles with 17 significant digits in %.17g format" },
+   { "hexfloat", BK_FLOAT,  0, gen_hexfloat, "hexadecimal doubles in %a format" },
+   { "ovf",      BK_INT,   10, gen_ovf,      "decimal integers of 20 to 24 digits that overflow (ERANGE)" },
+   { "dovf",     BK_FLOAT, 10, gen_dovf,     "doubles with exponents that overflow or underflow (ERANGE)" },
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   generators of the conversion loops
+\* ------------------------------------------------------------------------- */
+static uint64_t float_bits(long double v)
+{
+   double   d = (double) v;
+   uint64_t u;
+
+   memcpy(&u, &d, sizeof(u));
+   return (u);
+}/* uint64_t float_bits(long double v) */
+
+#ifdef _WIN32
+#define bench_strtold strtod
+#else
+#define bench_strtold strtold
+#endif
+
+#define BENCH_LOOP_R(fn)  static uint64_t loop_##fn(char * const * pps, size_t count, int base)  \
+                          { uint64_t s = 0; size_t i;                                            \
+                            for(i = 0; i < count; ++i) s += (uint64_t) fn(pps[i], NULL, base, NULL); \
+                            return (s); }
+
+#define BENCH_LOOP_E(fn)  static uint64_t loop_##fn(char * const * pps, size_t count, int base)  \
+                          { uint64_t s = 0; size_t i;                                            \
+                            for(i = 0; i < count; ++i) s += (uint64_t) fn(pps[i], NULL, base);  \
+                            return (s); }
+
+#define BENCH_LOOP_A(fn)  static uint64_t loop_##fn(char * const * pps, size_t count, int base)  \
+                          { uint64_t s = 0; size_t i; (void) base;                               \
+                            for(i = 0; i < count; ++i) s += (uint64_t) fn(pps[i]);               \
+                            return (s); }
+
+#define BENCH_LOOP_RET(fn) static uint64_t loop_##fn(char * const * pps, size_t count, int base) \
+                          { uint64_t s = 0; size_t i;                                            \
+                            for(i = 0; i < count; ++i) s += (uint64_t) fn(pps[i], base).value;  \
+                            return (s); }
+
+#define BENCH_LOOP_FRET(fn) static uint64_t loop_##fn(char * const * pps, size_t count, int base) \
+                          { uint64_t s = 0; size_t i;                                            \
+                            for(i = 0; i < count; ++i) s += float_bits(fn(pps[i], base).value); \
+                            return (s); }
+
+#define BENCH_LOOP_FR(fn) static uint64_t loop_##fn(char * const * pps, size_t count, int base)  \
+                          { uint64_t s = 0; size_t i;                                            \
+                            for(i = 0; i < count; ++i) s += float_bits(fn(pps[i], NULL, base, NULL)); \
+                            return (s); }
+
+#define BENCH_LOOP_FE(fn) static uint64_t loop_##fn(char * const * pps, size_t count, int base)  \
+                          { uint64_t s = 0; size_t i; (void) base;                               \
+                            for(i = 0; i < count; ++i) s += float_bits(fn(pps[i], NULL));        \
+                            return (s); }
+
+BENCH_LOOP_R(str2i8_r)
+BENCH_LOOP_E(str2i8)
+BENCH_LOOP_R(str2u8_r)
+BENCH_LOOP_E(str2u8)
+BENCH_LOOP_R(str2i16_r)
+BENCH_LOOP_E(str2i16)
+BENCH_LOOP_R(str2u16_r)
+BENCH_LOOP_E(str2u16)
+BENCH_LOOP_R(str2i32_r)
+BENCH_LOOP_E(str2i32)
+BENCH_LOOP_R(str2u32_r)
+BENCH_LOOP_E(str2u32)
+BENCH_LOOP_R(str2i64_r)
+BENCH_LOOP_E(str2i64)
+BENCH_LOOP_RET(str2i64_ret)
+BENCH_LOOP_R(str2u64_r)
+BENCH_LOOP_E(str2u64)
+BENCH_LOOP_RET(str2u64_ret)
+BENCH_LOOP_R(str2pd_r)
+BENCH_LOOP_E(str2pd)
+BENCH_LOOP_R(str2sz_r)
+BENCH_LOOP_E(str2sz)
+BENCH_LOOP_R(str2ip_r)
+BENCH_LOOP_E(str2ip)
+BENCH_LOOP_R(str2up_r)
+BENCH_LOOP_E(str2up)
+BENCH_LOOP_R(str2i_r)
+BENCH_LOOP_E(str2i)
+BENCH_LOOP_R(str2u_r)
+BENCH_LOOP_E(str2u)
+BENCH_LOOP_A(atoi)
+BENCH_LOOP_R(str2l_r)
+BENCH_LOOP_E(str2l)
+BENCH_LOOP_E(strtol)
+BENCH_LOOP_A(atol)
+BENCH_LOOP_R(str2ll_r)
+BENCH_LOOP_E(str2ll)
+BENCH_LOOP_E(strtoll)
+BENCH_LOOP_R(str2ul_r)
+BENCH_LOOP_E(str2ul)
+BENCH_LOOP_E(strtoul)
+BENCH_LOOP_R(str2ull_r)
+BENCH_LOOP_E(str2ull)
+BENCH_LOOP_E(strtoull)
+BENCH_LOOP_FE(str2f)
+BENCH_LOOP_FE(strtof)
+BENCH_LOOP_FR(str2d_r)
+BENCH_LOOP_FRET(str2d_ret)
+
+/* loop_s2n_lazy_scan only validates the numbers like the load of a document with lazy tokens */
+static uint64_t loop_s2n_lazy_scan(char * const * pps, size_t count, int base)
+{
+   uint64_t s = 0;
+   size_t   i;
+   s2n_lazy l;
+   (void) base;
+
+   for(i = 0; i < count; ++i)
+   {
+      s2n_lazy_scan(&l, pps[i], NULL);
+      s += l.len;
+   }
+
+   return (s);
+}/* uint64_t loop_s2n_lazy_scan(char * const * pps, size_t count, int base) */
+
+/* loop_s2n_lazy_d validates the numbers and converts them on the first access */
+static uint64_t loop_s2n_lazy_d(char * const * pps, size_t count, int base)
+{
+   uint64_t s = 0;
+   size_t   i;
+   s2n_lazy l;
+   double   d = 0.0;
+   (void) base;
+
+   for(i = 0; i < count; ++i)
+   {
+      s2n_lazy_scan(&l, pps[i], NULL);
+      s2n_lazy_d(&l, &d);
+      s += float_bits(d);
+   }
+
+   return (s);
+}/* uint64_t loop_s2n_lazy_d(char * const * pps, size_t count, int base) */
+
+/* loop_str2num_any converts the numbers to the type that fits */
+static uint64_t loop_str2num_any(char * const * pps, size_t count, int base)
+{
+   uint64_t s = 0;
+   size_t   i;
+
+   for(i = 0; i < count; ++i)
+      s += str2num_any(pps[i], base).value.u64;
+
+   return (s);
+}/* uint64_t loop_str2num_any(char * const * pps, size_t count, int base) */
+BENCH_LOOP_FE(str2d)
+BENCH_LOOP_FE(strtod)
+BENCH_LOOP_FR(str2ld_r)
+BENCH_LOOP_FE(str2ld)
+BENCH_LOOP_FE(bench_strtold)
+
+/* benchmarked functions */
+static const BENCH_FUNC bench_funcs[] =
+{
+   { "str2i8_r",  BK_INT,   loop_str2i8_r       },
+   { "str2i8",    BK_INT,   loop_str2i8         },
+   { "str2u8_r",  BK_INT,   loop_str2u8_r       },
+   { "str2u8",    BK_INT,   loop_str2u8         },
+   { "str2i16_r", BK_INT,   loop_str2i16_r      },
+   { "str2i16",   BK_INT,   loop_str2i16        },
+   { "str2u16_r", BK_INT,   loop_str2u16_r      },
+   { "str2u16",   BK_INT,   loop_str2u16        },
+   { "str2i32_r", BK_INT,   loop_str2i32_r      },
+   { "str2i32",   BK_INT,   loop_str2i32        },
+   { "str2u32_r", BK_INT,   loop_str2u32_r      },
+   { "str2u32",   BK_INT,   loop_str2u32        },
+   { "str2i64_r", BK_INT,   loop_str2i64_r      },
+   { "str2i64",   BK_INT,   loop_str2i64        },
+   { "str2i64_ret", BK_INT, loop_str2i64_ret    },
+   { "str2u64_r", BK_INT,   loop_str2u64_r      },
+   { "str2u64",   BK_INT,   loop_str2u64        },
+   { "str2u64_ret", BK_INT, loop_str2u64_ret    },
+   { "str2pd_r",  BK_INT,   loop_str2pd_r       },
+   { "str2pd",    BK_INT,   loop_str2pd         },
+   { "str2sz_r",  BK_INT,   loop_str2sz_r       },
+   { "str2sz",    BK_INT,   loop_str2sz         },
+   { "str2ip_r",  BK_INT,   loop_str2ip_r       },
+   { "str2ip",    BK_INT,   loop_str2ip         },
+   { "str2up_r",  BK_INT,   loop_str2up_r       },
+   { "str2up",    BK_INT,   loop_str2up         },
+   { "str2i_r",   BK_INT,   loop_str2i_r        },
+   { "str2i",     BK_INT,   loop_str2i          },
+   { "str2u_r",   BK_INT,   loop_str2u_r        },
+   { "str2u",     BK_INT,   loop_str2u          },
+   { "atoi",      BK_INT,   loop_atoi           },
+   { "str2l_r",   BK_INT,   loop_str2l_r        },
+   { "str2l",     BK_INT,   loop_str2l          },
+   { "strtol",    BK_INT,   loop_strtol         },
+   { "atol",      BK_INT,   loop_atol           },
+   { "str2ll_r",  BK_INT,   loop_str2ll_r       },
+   { "str2ll",    BK_INT,   loop_str2ll         },
+   { "strtoll",   BK_INT,   loop_strtoll        },
+   { "str2ul_r",  BK_INT,   loop_str2ul_r       },
+   { "str2ul",    BK_INT,   loop_str2ul         },
+   { "strtoul",   BK_INT,   loop_strtoul        },
+   { "str2ull_r", BK_INT,   loop_str2ull_r      },
+   { "str2ull",   BK_INT,   loop_str2ull        },
+   { "strtoull",  BK_INT,   loop_strtoull       },
+   { "str2f",     BK_FLOAT, loop_str2f          },
+   { "strtof",    BK_FLOAT, loop_strtof         },
+   { "str2d_r",   BK_FLOAT, loop_str2d_r        },
+   { "str2d_ret", BK_FLOAT, loop_str2d_ret      },
+   { "s2n_lazy_scan", BK_FLOAT, loop_s2n_lazy_scan },
+   { "s2n_lazy_d",    BK_FLOAT, loop_s2n_lazy_d    },
+   { "str2num_any",   BK_ANY,   loop_str2num_any   },
+   { "str2d",     BK_FLOAT, loop_str2d          },
+   { "strtod",    BK_FLOAT, loop_strtod         },
+   { "str2ld_r",  BK_FLOAT, loop_str2ld_r       },
+   { "str2ld",    BK_FLOAT, loop_str2ld         },
+   { "strtold",   BK_FLOAT, loop_bench_strtold  },
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   name_selected checks if a name is part of a comma separated list of names.
+   A trailing '*' of a name of the list matches all names with that prefix.
+\* ------------------------------------------------------------------------- */
+static int name_selected(const char * plist, const char * pname)
+{
+   size_t len = strlen(pname);
+
+   if(!plist)
+      return (1);
+
+   while(*plist)
+   {
+      const char * pend = strchr(plist, ',');
+      size_t       n    = pend ? (size_t) (pend - plist) : strlen(plist);
+
+      if(n && (plist[n - 1] == '*') && !strncmp(plist, pname, n - 1))
+         return (1);
+
+      if((n == len) && !strncmp(plist, pname, n))
+         return (1);
+
+      plist += n;
+      if(*plist)
+         ++plist;
+   }
+
+   return (0);
+}/* int name_selected(const char * plist, const char * pname) */
+
+
+/* ------------------------------------------------------------------------- *\
+   input_free releases the strings of an input
+\* ------------------------------------------------------------------------- */
+static void input_free(BENCH_INPUT * pin)
+{
+   if(pin->pps)
+      free(pin->pps);
+   if(pin->pbuf)
+      free(pin->pbuf);
+   memset(pin, 0, sizeof(*pin));
+}/* void input_free(BENCH_INPUT * pin) */
+
+
+/* ------------------------------------------------------------------------- *\
+   input_generate creates count strings of a class. The strings are stored
+   one after another in a single buffer as they would be in a file.
+\* ------------------------------------------------------------------------- */
+static int input_generate(BENCH_INPUT * pin, const BENCH_CLASS * pc, size_t count)
+{
+   BENCH_RNG rng;
+   char *    ps;
+   size_t    i;
+
+   memset(pin, 0, sizeof(*pin));
+   pin->name  = pc->name;
+   pin->kind  = pc->kind;
+   pin->base  = pc->base;
+   pin->count = count;
+   pin->pps   = (char **) malloc(count * sizeof(char *));
+   pin->pbuf  = (char *)  malloc(count * (BENCH_MAX_LEN + 1));
+
+   if(!pin->pps || !pin->pbuf)
+   {
+      input_free(pin);
+      return (0);
+   }
+
+   rng.s = 0x9E3779B97F4A7C15ULL ^ (uint64_t) strlen(pc->name);
+   ps    = pin->pbuf;
+
+   for(i = 0; i < count; ++i)
+   {
+      size_t len;
+
+      pc->gen(&rng, ps);
+      len = strlen(ps);
+
+      pin->pps[i] = ps;
+      pin->bytes += len;
+      ps += len + 1;
+   }
+
+   return (1);
+}/* int input_generate(BENCH_INPUT * pin, const BENCH_CLASS * pc, size_t count) */
+
+
+/* ------------------------------------------------------------------------- *\
+   input_load reads a file with one number per line. Empty lines are skipped.
+   The input is of the kind BK_FLOAT if any number contains a decimal point,
+   an exponent or is an infinite value or NaN.
+\* ------------------------------------------------------------------------- */
+static int input_load(BENCH_INPUT * pin, const char * path, int base)
+{
+   FILE * pf   = fopen(path, "rb");
+   long   size = -1;
+   char * ps;
+   char * pend;
+   size_t i;
+
+   memset(pin, 0, sizeof(*pin));
+
+   if(pf && !fseek(pf, 0, SEEK_END))
+      size = ftell(pf);
+
+   if(!pf || (size < 0) || fseek(pf, 0, SEEK_SET))
+   {
+      sfprintf(stderr, "Can't read the data file %s!\n", path);
+      if(pf)
+         fclose(pf);
+      return (0);
+   }
+
+   pin->name = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+   pin->kind = BK_INT;
+   pin->base = base;
+   pin->pbuf = (char *) malloc((size_t) size + 1);
+   pin->pps  = (char **) malloc(((size_t) size / 2 + 1) * sizeof(char *));
+
+   if(!pin->pbuf || !pin->pps || (fread(pin->pbuf, 1, (size_t) size, pf) != (size_t) size))
+   {
+      sfprintf(stderr, "Can't read the data file %s!\n", path);
+      fclose(pf);
+      input_free(pin);
+      return (0);
+   }
+
+   fclose(pf);
+   pin->pbuf[size] = '\0';
+
+   for(ps = pin->pbuf; *ps; ps = pend)
+   {
+      char * pnl = strchr(ps, '\n');
+
+      pend = pnl ? pnl + 1 : ps + strlen(ps);
+      if(pnl)
+         *pnl = '\0';
+      if(pnl && (pnl > ps) && (pnl[-1] == '\r'))
+         pnl[-1] = '\0';
+
+      if(!*ps)
+         continue;
+
+      pin->pps[pin->count++] = ps;
+      pin->bytes += strlen(ps);
+
+      if(pin->kind == BK_INT)
+      {
+         for(i = 0; ps[i]; ++i)
+         {
+            char c = ps[i];
+
+            if((c == '.') || (c == '~') || ((base <= 10) && strchr("eEpPnN", c)))
+               pin->kind = BK_FLOAT;
+         }
+      }
+   }
+
+   if(!pin->count)
+   {
+      sfprintf(stderr, "The data file %s contains no numbers!\n", path);
+      input_free(pin);
+      return (0);
+   }
+
+   return (1);
+}/* int input_load(BENCH_INPUT * pin, const char * path, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   cmp_double compares two doubles for qsort
+\* ------------------------------------------------------------------------- */
+static int cmp_double(const void * pv0, const void * pv1)
+{
+   double d0 = *(const double *) pv0;
+   double d1 = *(const double *) pv1;
+
+   return ((d0 < d1) ? -1 : (d0 > d1));
+}/* int cmp_double(const void * pv0, const void * pv1) */
+
+
+/* ------------------------------------------------------------------------- *\
+   percentile returns the p-th percentile (0 < p <= 1) of a sorted array
+\* ------------------------------------------------------------------------- */
+static double percentile(const double * pd, size_t count, double p)
+{
+   size_t i = (size_t) (p * (double) count + 0.999999);
+
+   if(i)
+      --i;
+   if(i >= count)
+      i = count - 1;
+
+   return (pd[i]);
+}/* double percentile(const double * pd, size_t count, double p) */
+
+
+/* ------------------------------------------------------------------------- *\
+   bench_sqrt calculates a square root without requiring libm
+\* ------------------------------------------------------------------------- */
+static double bench_sqrt(double d)
+{
+   double r = d;
+   int    i;
+
+   if(d <= 0.0)
+      return (0.0);
+
+   if(r < 1.0)
+      r = 1.0;
+
+   for(i = 0; i < 64; ++i)
+   {
+      double n = 0.5 * (r + d / r);
+      if(n >= r)
+         break;
+      r = n;
+   }
+
+   return (r);
+}/* double bench_sqrt(double d) */
+
+
+/* names of the hardware performance counters */
+static const char * const counter_name[BENCH_COUNTERS] = { "ins", "cycles", "br-miss", "l1d-miss" };
+
+/* file descriptors of the hardware performance counters or -1 if not available */
+static int counter_fd[BENCH_COUNTERS] = { -1, -1, -1, -1 };
+
+
+/* ------------------------------------------------------------------------- *\
+   perf_open opens the hardware performance counters of the calling thread.
+   It returns 0 if none of the counters is available as it is common in
+   containers and virtual machines.
+\* ------------------------------------------------------------------------- */
+static int perf_open()
+{
+   int n = 0;
+
+#if HAVE_PERF
+   static const uint32_t type[BENCH_COUNTERS]   = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE };
+   static const uint64_t config[BENCH_COUNTERS] = { PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES,
+                                                    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) };
+   int i;
+
+   for(i = 0; i < BENCH_COUNTERS; ++i)
+   {
+      struct perf_event_attr pea;
+
+      memset(&pea, 0, sizeof(pea));
+      pea.type           = type[i];
+      pea.size           = sizeof(pea);
+      pea.config         = config[i];
+      pea.disabled       = 1;
+      pea.exclude_kernel = 1;
+      pea.exclude_hv     = 1;
+
+      counter_fd[i] = (int) syscall(__NR_perf_event_open, &pea, 0, -1, -1, 0);
+      if(counter_fd[i] >= 0)
+         ++n;
+   }
+#endif
+
+   if(!n)
+      sfprintf(stderr, "Hardware performance counters are not available (%s).\n",
+               HAVE_PERF ? strerror(errno) : "no perf_event_open");
+
+   return (n);
+}/* int perf_open() */
+
+
+/* ------------------------------------------------------------------------- *\
+   perf_start resets and enables the hardware performance counters
+\* ------------------------------------------------------------------------- */
+static void perf_start()
+{
+#if HAVE_PERF
+   int i;
+
+   for(i = 0; i < BENCH_COUNTERS; ++i)
+   {
+      if(counter_fd[i] >= 0)
+      {
+         ioctl(counter_fd[i], PERF_EVENT_IOC_RESET, 0);
+         ioctl(counter_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+   }
+#endif
+}/* void perf_start() */
+
+
+/* ------------------------------------------------------------------------- *\
+   perf_stop disables the hardware performance counters and stores their
+   values divided by count or -1 for the unavailable ones
+\* ------------------------------------------------------------------------- */
+static void perf_stop(double * pcounter, double count)
+{
+   int i;
+
+   for(i = 0; i < BENCH_COUNTERS; ++i)
+   {
+      pcounter[i] = -1.0;
+
+#if HAVE_PERF
+      if(counter_fd[i] >= 0)
+      {
+         uint64_t v = 0;
+
+         ioctl(counter_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+         if(read(counter_fd[i], &v, sizeof(v)) == (ssize_t) sizeof(v))
+            pcounter[i] = (double) v / count;
+      }
+#endif
+   }
+}/* void perf_stop(double * pcounter, double count) */
+
+
+/* ------------------------------------------------------------------------- *\
+   bench_measure runs warmup passes and timed trials of a function over all
+   strings of an input
+\* ------------------------------------------------------------------------- */
+static int bench_measure(const BENCH_FUNC * pf, const BENCH_INPUT * pin, const BENCH_OPT * popt, BENCH_RESULT * pr)
+{
+   double * pns  = (double *) malloc((size_t) popt->trials * sizeof(double));
+   double * pcyc = (double *) malloc((size_t) popt->trials * sizeof(double));
+   double   sum  = 0.0;
+   double   sq   = 0.0;
+   int      i;
+
+   memset(pr, 0, sizeof(*pr));
+
+   if(!pns || !pcyc)
+   {
+      if(pns)
+         free(pns);
+      if(pcyc)
+         free(pcyc);
+      return (0);
+   }
+
+   /* The warmup trains the branch predictors and loads the caches. */
+   for(i = 0; i < popt->warmup; ++i)
+      bench_sink = bench_sink + pf->loop(pin->pps, pin->count, pin->base);
+
+   if(popt->perf)
+      perf_start();
+
+   for(i = 0; i < popt->trials; ++i)
+   {
+      uint64_t c0 = bench_cycles();
+      uint64_t t0 = bench_ns();
+      uint64_t t1;
+      uint64_t c1;
+
+      bench_sink = bench_sink + pf->loop(pin->pps, pin->count, pin->base);
+
+      t1 = bench_ns();
+      c1 = bench_cycles();
+
+      pns[i]  = (double) (t1 - t0) / (double) pin->count;
+      pcyc[i] = (double) (c1 - c0) / (double) pin->count;
+      sum    += pns[i];
+      sq     += pns[i] * pns[i];
+   }
+
+   if(popt->perf)
+      perf_stop(pr->counter, (double) pin->count * popt->trials);
+   else
+      perf_stop(pr->counter, 1.0);
+
+   qsort(pns,  (size_t) popt->trials, sizeof(double), cmp_double);
+   qsort(pcyc, (size_t) popt->trials, sizeof(double), cmp_double);
+
+   pr->trials     = popt->trials;
+   pr->ns_median  = percentile(pns, (size_t) popt->trials, 0.5);
+   pr->ns_p99     = percentile(pns, (size_t) popt->trials, 0.99);
+   pr->ns_mean    = sum / popt->trials;
+   pr->ns_stddev  = (popt->trials > 1) ? bench_sqrt((sq - sum * pr->ns_mean) / (popt->trials - 1)) : 0.0;
+   pr->cyc_median = percentile(pcyc, (size_t) popt->trials, 0.5);
+   pr->mb_s       = (pr->ns_median > 0.0) ? ((double) pin->bytes / (double) pin->count) * 1000.0 / pr->ns_median : 0.0;
+
+   free(pns);
+   free(pcyc);
+
+   return (1);
+}/* int bench_measure(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   print_header prints the header of the table of the results
+\* ------------------------------------------------------------------------- */
+static void print_header(const BENCH_OPT * popt)
+{
+   int i;
+
+   if(popt->threads)
+   {
+      sfprintf(stdout, "\n%-14s %-10s %7s %9s %8s %9s %9s %10s\n", "function", "input", "threads",
+               "ns/value", "stddev", "Mvalues/s", "MB/s", "efficiency");
+      return;
+   }
+
+   if(popt->latency)
+   {
+      sfprintf(stdout, "\n%-14s %-10s %8s %8s %8s %8s  %8s %8s %8s %8s\n", "function", "input",
+               "ns p50", "p90", "p99", "p99.9", "cyc p50", "p90", "p99", "p99.9");
+      return;
+   }
+
+   sfprintf(stdout, "\n%-14s %-10s %9s %9s %8s %9s %9s", "function", "input", "ns/value", "p99", "stddev",
+            HAVE_TSC ? "cyc/value" : "cycles(-)", "MB/s");
+
+   if(popt->perf)
+   {
+      for(i = 0; i < BENCH_COUNTERS; ++i)
+         sfprintf(stdout, " %9s", counter_name[i]);
+   }
+
+   sfprintf(stdout, "\n");
+}/* void print_header(const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   print_result prints the results of a benchmark. The hardware events are
+   given per value.
+\* ------------------------------------------------------------------------- */
+static void print_result(const char * pfunc, const char * pinput, const BENCH_RESULT * pr, const BENCH_OPT * popt)
+{
+   int i;
+
+   sfprintf(stdout, "%-14s %-10s %9.2f %9.2f %8.2f %9.1f %9.1f", pfunc, pinput,
+            pr->ns_median, pr->ns_p99, pr->ns_stddev, pr->cyc_median, pr->mb_s);
+
+   if(popt->perf)
+   {
+      for(i = 0; i < BENCH_COUNTERS; ++i)
+      {
+         if(pr->counter[i] < 0.0)
+            sfprintf(stdout, " %9s", "-");
+         else
+            sfprintf(stdout, " %9.2f", pr->counter[i]);
+      }
+   }
+
+   sfprintf(stdout, "\n");
+}/* void print_result(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Result files
+\* ------------------------------------------------------------------------- */
+
+#ifndef BENCH_CFLAGS
+#ifdef __OPTIMIZE__
+#define BENCH_CFLAGS "optimized"
+#else
+#define BENCH_CFLAGS "not optimized"
+#endif
+#endif
+
+#define BENCH_STR(x)  BENCH_STR_(x)
+#define BENCH_STR_(x) #x
+
+#if defined (__clang__)
+#define BENCH_COMPILER "clang " __clang_version__
+#elif defined (__GNUC__)
+#define BENCH_COMPILER "gcc " __VERSION__
+#elif defined (_MSC_VER)
+#define BENCH_COMPILER "msvc " BENCH_STR(_MSC_FULL_VER)
+#else
+#define BENCH_COMPILER "unknown"
+#endif
+
+/* results of a function for an input */
+typedef struct BENCH_RECORD_S BENCH_RECORD;
+struct BENCH_RECORD_S
+{
+   char         func[32];  /* name of the function */
+   char         input[64]; /* name of the input */
+   BENCH_RESULT r;         /* results */
+};
+
+static BENCH_RECORD * precords     = NULL; /* results of all benchmarks */
+static size_t         records      = 0;    /* number of results */
+static size_t         records_size = 0;    /* number of results that fit into precords */
+
+
+/* ------------------------------------------------------------------------- *\
+   record_add appends a result to the results of all benchmarks
+\* ------------------------------------------------------------------------- */
+static int record_add(const char * pfunc, const char * pinput, const BENCH_RESULT * pr)
+{
+   BENCH_RECORD * prec;
+
+   if(records >= records_size)
+   {
+      size_t         size = records_size ? 2 * records_size : 64;
+      BENCH_RECORD * pnew = (BENCH_RECORD *) realloc(precords, size * sizeof(BENCH_RECORD));
+
+      if(!pnew)
+         return (0);
+
+      precords     = pnew;
+      records_size = size;
+   }
+
+   prec = &precords[records++];
+   memset(prec, 0, sizeof(*prec));
+   strncpy(prec->func,  pfunc,  sizeof(prec->func) - 1);
+   strncpy(prec->input, pinput, sizeof(prec->input) - 1);
+   prec->r = *pr;
+
+   return (1);
+}/* int record_add(const char * pfunc, const char * pinput, const BENCH_RESULT * pr) */
+
+
+/* ------------------------------------------------------------------------- *\
+   cpu_model stores the model name of the CPU in a buffer of at least 64 bytes
+\* ------------------------------------------------------------------------- */
+static void cpu_model(char * pbuf, size_t size)
+{
+#if HAVE_TSC
+   /* processor brand string of the extended cpuid leafs 0x80000002 to 0x80000004 */
+   uint32_t r[12];
+   int      i;
+
+   for(i = 0; i < 3; ++i)
+   {
+#if defined (_MSC_VER)
+      int regs[4];
+      __cpuid(regs, 0x80000002 + i);
+      memcpy(&r[i * 4], regs, sizeof(regs));
+#else
+      __asm__ __volatile__ ("cpuid" : "=a" (r[i * 4]), "=b" (r[i * 4 + 1]), "=c" (r[i * 4 + 2]), "=d" (r[i * 4 + 3])
+                                    : "a" (0x80000002 + i), "c" (0));
+#endif
+   }
+
+   memcpy(pbuf, r, 48);
+   pbuf[48] = '\0';
+#else
+   FILE * pf = fopen("/proc/cpuinfo", "r");
+
+   strcpy(pbuf, "unknown");
+
+   if(pf)
+   {
+      char line[256];
+
+      while(fgets(line, sizeof(line), pf))
+      {
+         char * pc = strchr(line, ':');
+
+         if(pc && (!strncmp(line, "model name", 10) || !strncmp(line, "Hardware", 8) || !strncmp(line, "cpu\t", 4)))
+         {
+            strncpy(pbuf, pc + 1, size - 1);
+            pbuf[size - 1] = '\0';
+            pbuf[strcspn(pbuf, "\r\n")] = '\0';
+            break;
+         }
+      }
+      fclose(pf);
+   }
+#endif
+
+   /* remove leading and trailing blanks */
+   while(*pbuf == ' ')
+      memmove(pbuf, pbuf + 1, strlen(pbuf));
+   while(*pbuf && (pbuf[strlen(pbuf) - 1] == ' '))
+      pbuf[strlen(pbuf) - 1] = '\0';
+
+   (void) size;
+}/* void cpu_model(char * pbuf, size_t size) */
+
+
+/* ------------------------------------------------------------------------- *\
+   put_str writes a quoted string into a JSON or CSV file
+\* ------------------------------------------------------------------------- */
+static void put_str(FILE * pf, const char * ps, int json)
+{
+   fputc('"', pf);
+
+   for(; *ps; ++ps)
+   {
+      if(*ps == '"')
+         fputs(json ? "\\\"" : "\"\"", pf);
+      else if(json && (*ps == '\\'))
+         fputs("\\\\", pf);
+      else if((uint8_t) *ps >= ' ')
+         fputc(*ps, pf);
+   }
+
+   fputc('"', pf);
+}/* void put_str(FILE * pf, const char * ps, int json) */
+
+
+/* ------------------------------------------------------------------------- *\
+   write_results writes the results of all benchmarks into a JSON file or
+   into a CSV file if the name of the file ends with .csv
+\* ------------------------------------------------------------------------- */
+static int write_results(const char * path, const BENCH_OPT * popt)
+{
+   static const char * const json_counter[BENCH_COUNTERS] = { "instructions", "hw_cycles", "branch_misses", "l1d_misses" };
+
+   size_t len  = strlen(path);
+   int    json = (len < 4) || strcmp(path + len - 4, ".csv");
+   FILE * pf   = fopen(path, "w");
+   char   cpu[256];
+   size_t i;
+   int    c;
+
+   if(!pf)
+   {
+      sfprintf(stderr, "Can't write the result file %s!\n", path);
+      return (0);
+   }
+
+   cpu_model(cpu, sizeof(cpu));
+
+   if(json)
+   {
+      fprintf(pf, "{\n  \"compiler\": ");
+      put_str(pf, BENCH_COMPILER, 1);
+      fprintf(pf, ",\n  \"flags\": ");
+      put_str(pf, BENCH_CFLAGS, 1);
+      fprintf(pf, ",\n  \"cpu\": ");
+      put_str(pf, cpu, 1);
+      fprintf(pf, ",\n  \"count\": %lu,\n  \"trials\": %d,\n  \"warmup\": %d,\n  \"results\": [\n",
+              (unsigned long) popt->count, popt->trials, popt->warmup);
+   }
+   else
+   {
+      fprintf(pf, "function,input,ns_median,ns_p99,ns_mean,ns_stddev,trials,cycles,mb_s");
+      for(c = 0; c < BENCH_COUNTERS; ++c)
+         fprintf(pf, ",%s", json_counter[c]);
+      fprintf(pf, ",compiler,flags,cpu\n");
+   }
+
+   for(i = 0; i < records; ++i)
+   {
+      const BENCH_RECORD * prec = &precords[i];
+
+      if(json)
+      {
+         fprintf(pf, "    {\"function\": ");
+         put_str(pf, prec->func, 1);
+         fprintf(pf, ", \"input\": ");
+         put_str(pf, prec->input, 1);
+         fprintf(pf, ", \"ns_median\": %.4f, \"ns_p99\": %.4f, \"ns_mean\": %.4f, \"ns_stddev\": %.4f, \"trials\": %d, \"cycles\": %.3f, \"mb_s\": %.3f",
+                 prec->r.ns_median, prec->r.ns_p99, prec->r.ns_mean, prec->r.ns_stddev, prec->r.trials, prec->r.cyc_median, prec->r.mb_s);
+
+         for(c = 0; c < BENCH_COUNTERS; ++c)
+         {
+            if(prec->r.counter[c] < 0.0)
+               fprintf(pf, ", \"%s\": null", json_counter[c]);
+            else
+               fprintf(pf, ", \"%s\": %.4f", json_counter[c], prec->r.counter[c]);
+         }
+
+         fprintf(pf, "}%s\n", (i + 1 < records) ? "," : "");
+      }
+      else
+      {
+         put_str(pf, prec->func, 0);
+         fputc(',', pf);
+         put_str(pf, prec->input, 0);
+         fprintf(pf, ",%.4f,%.4f,%.4f,%.4f,%d,%.3f,%.3f", prec->r.ns_median, prec->r.ns_p99, prec->r.ns_mean,
+                 prec->r.ns_stddev, prec->r.trials, prec->r.cyc_median, prec->r.mb_s);
+
+         for(c = 0; c < BENCH_COUNTERS; ++c)
+         {
+            if(prec->r.counter[c] < 0.0)
+               fprintf(pf, ",");
+            else
+               fprintf(pf, ",%.4f", prec->r.counter[c]);
+         }
+
+         fputc(',', pf);
+         put_str(pf, BENCH_COMPILER, 0);
+         fputc(',', pf);
+         put_str(pf, BENCH_CFLAGS, 0);
+         fputc(',', pf);
+         put_str(pf, cpu, 0);
+         fputc('\n', pf);
+      }
+   }
+
+   if(json)
+      fprintf(pf, "  ]\n}\n");
+
+   if(fclose(pf))
+   {
+      sfprintf(stderr, "Can't write the result file %s!\n", path);
+      return (0);
+   }
+
+   return (1);
+}/* int write_results(const char * path, const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   json_value returns the position of the value of a key of a line of a
+   JSON file or NULL
+\* ------------------------------------------------------------------------- */
+static const char * json_value(const char * pline, const char * pkey)
+{
+   size_t len = strlen(pkey);
+
+   while((pline = strchr(pline, '"')) != NULL)
+   {
+      ++pline;
+      if(!strncmp(pline, pkey, len) && (pline[len] == '"'))
+      {
+         pline += len + 1;
+         while((*pline == ' ') || (*pline == ':'))
+            ++pline;
+         return (pline);
+      }
+   }
+
+   return (NULL);
+}/* const char * json_value(const char * pline, const char * pkey) */
+
+
+/* ------------------------------------------------------------------------- *\
+   csv_field copies the field with index idx of a CSV line into a buffer
+\* ------------------------------------------------------------------------- */
+static int csv_field(const char * pline, int idx, char * pbuf, size_t size)
+{
+   size_t n = 0;
+
+   while(idx--)
+   {
+      int quoted = 0;
+
+      while(*pline && ((*pline != ',') || quoted))
+      {
+         if(*pline == '"')
+            quoted = !quoted;
+         ++pline;
+      }
+
+      if(*pline++ != ',')
+         return (0);
+   }
+
+   if(*pline == '"')
+   {
+      for(++pline; *pline && (n + 1 < size); ++pline)
+      {
+         if(*pline == '"')
+         {
+            if(pline[1] != '"')
+               break;
+            ++pline;
+         }
+         pbuf[n++] = *pline;
+      }
+   }
+   else
+   {
+      while(*pline && (*pline != ',') && (*pline != '\r') && (*pline != '\n') && (n + 1 < size))
+         pbuf[n++] = *pline++;
+   }
+
+   pbuf[n] = '\0';
+   return (1);
+}/* int csv_field(const char * pline, int idx, char * pbuf, size_t size) */
+
+
+/* ------------------------------------------------------------------------- *\
+   compare_results compares the results with the ones of a baseline file of
+   write_results. A result is a regression if its mean is more than
+   threshold percent slower and Welch's t-test of both means exceeds 3.
+   The function returns the number of regressions or -1 in case of errors.
+\* ------------------------------------------------------------------------- */
+static int compare_results(const char * path, double threshold)
+{
+   static const char * const csv_name[] = { "function", "input", "ns_mean", "ns_stddev", "trials" };
+
+   FILE * pf         = fopen(path, "r");
+   char   line[4096];
+   int    col[5]     = { -1, -1, -1, -1, -1 };
+   int    json       = -1;
+   int    matches    = 0;
+   int    regression = 0;
+
+   if(!pf)
+   {
+      sfprintf(stderr, "Can't read the baseline file %s!\n", path);
+      return (-1);
+   }
+
+   sfprintf(stdout, "\ncomparison with %s (threshold %.1f%%)\n", path, threshold);
+   sfprintf(stdout, "%-14s %-10s %10s %10s %8s %8s\n", "function", "input", "baseline", "current", "change", "t");
+
+   while(fgets(line, sizeof(line), pf))
+   {
+      char   func[32];
+      char   input[64];
+      char   num[64];
+      double mean0;
+      double dev0;
+      double n0;
+      size_t i;
+
+      if(json < 0)
+      {
+         json = (line[0] == '{');
+
+         if(!json)
+         {
+            /* The header of CSV files defines the columns. */
+            for(i = 0; (i < 64) && csv_field(line, (int) i, num, sizeof(num)); ++i)
+            {
+               size_t k;
+               for(k = 0; k < ARRAY_SIZE(csv_name); ++k)
+               {
+                  if(!strcmp(num, csv_name[k]))
+                     col[k] = (int) i;
+               }
+            }
+
+            if((col[0] < 0) || (col[1] < 0) || (col[2] < 0) || (col[3] < 0) || (col[4] < 0))
+               break;
+            continue;
+         }
+      }
+
+      if(json)
+      {
+         const char * pf_  = json_value(line, "function");
+         const char * pi_  = json_value(line, "input");
+         const char * pm   = json_value(line, "ns_mean");
+         const char * pd   = json_value(line, "ns_stddev");
+         const char * pt   = json_value(line, "trials");
+
+         if(!pf_ || !pi_ || !pm || !pd || !pt || (*pf_ != '"') || (*pi_ != '"'))
+            continue;
+
+         i = strcspn(pf_ + 1, "\"");
+         if(i >= sizeof(func))
+            continue;
+         memcpy(func, pf_ + 1, i);
+         func[i] = '\0';
+
+         i = strcspn(pi_ + 1, "\"");
+         if(i >= sizeof(input))
+            continue;
+         memcpy(input, pi_ + 1, i);
+         input[i] = '\0';
+
+         mean0 = str2d(pm, NULL);
+         dev0  = str2d(pd, NULL);
+         n0    = str2d(pt, NULL);
+      }
+      else
+      {
+         if(!csv_field(line, col[0], func, sizeof(func)) || !csv_field(line, col[1], input, sizeof(input)))
+            continue;
+
+         mean0 = csv_field(line, col[2], num, sizeof(num)) ? str2d(num, NULL) : 0.0;
+         dev0  = csv_field(line, col[3], num, sizeof(num)) ? str2d(num, NULL) : 0.0;
+         n0    = csv_field(line, col[4], num, sizeof(num)) ? str2d(num, NULL) : 0.0;
+      }
+
+      for(i = 0; i < records; ++i)
+      {
+         const BENCH_RECORD * prec = &precords[i];
+         double               se;
+         double               t;
+         double               change;
+
+         if(strcmp(prec->func, func) || strcmp(prec->input, input) || (mean0 <= 0.0) || (n0 < 1.0))
+            continue;
+
+         ++matches;
+
+         se     = bench_sqrt(dev0 * dev0 / n0 + prec->r.ns_stddev * prec->r.ns_stddev / prec->r.trials);
+         change = (prec->r.ns_mean - mean0) * 100.0 / mean0;
+         t      = (se > 0.0) ? (prec->r.ns_mean - mean0) / se : ((prec->r.ns_mean > mean0) ? 1e9 : 0.0);
+
+         sfprintf(stdout, "%-14s %-10s %10.2f %10.2f %7.1f%% %8.1f", func, input, mean0, prec->r.ns_mean, change, t);
+
+         if((change > threshold) && (t > 3.0))
+         {
+            sfprintf(stdout, "  SLOWER\n");
+            ++regression;
+         }
+         else
+         {
+            sfprintf(stdout, "\n");
+         }
+         break;
+      }
+   }
+
+   fclose(pf);
+
+   if(!matches)
+   {
+      sfprintf(stderr, "The baseline file %s contains no matching results!\n", path);
+      return (-1);
+   }
+
+   sfprintf(stdout, "%d of %d results are significantly slower than the baseline\n", regression, matches);
+
+   return (regression);
+}/* int compare_results(const char * path, double threshold) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Scaling benchmark
+\* ------------------------------------------------------------------------- */
+
+/* functions and input classes of the scaling benchmark unless -f or -c select others */
+#define SCALE_FUNCS   "str2i64_r,str2i64,strtoll,str2d_r,str2d,strtod"
+#define SCALE_CLASSES "dec18,ovf,d17,dovf"
+
+/* counters of the start barrier of the threads */
+#if defined (_WIN32)
+typedef volatile LONG SCALE_ATOMIC;
+#define SCALE_INC(p)      InterlockedIncrement(p)
+#define SCALE_LOAD(p)     InterlockedCompareExchange((p), 0, 0)
+#define SCALE_STORE(p, v) InterlockedExchange((p), (v))
+#elif !defined (__cplusplus) && defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined (__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+typedef atomic_int SCALE_ATOMIC;
+#define SCALE_INC(p)      atomic_fetch_add((p), 1)
+#define SCALE_LOAD(p)     atomic_load(p)
+#define SCALE_STORE(p, v) atomic_store((p), (v))
+#else /* C++ and older C compilers */
+typedef int SCALE_ATOMIC;
+#define SCALE_INC(p)      __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define SCALE_LOAD(p)     __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define SCALE_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
+/* job of a thread of the scaling benchmark */
+typedef struct SCALE_JOB_S SCALE_JOB;
+struct SCALE_JOB_S
+{
+   const BENCH_FUNC *  pf;     /* benchmarked function */
+   const BENCH_INPUT * pin;    /* shared input of all threads */
+   const BENCH_OPT *   popt;   /* options */
+   SCALE_ATOMIC *      pready; /* number of threads that finished their warmup */
+   SCALE_ATOMIC *      pgo;    /* start signal of all threads */
+   int                 wait;   /* number of threads the main thread waits for or 0 */
+   uint64_t            t0;     /* start of the timed trials of all threads in ns (main thread) */
+   uint64_t            t1;     /* end of the timed trials in ns */
+   uint64_t            sum;    /* checksum of the values */
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   scale_run runs the warmup passes of a thread, waits for the start signal
+   and runs the timed trials afterwards. The main thread gives the start
+   signal after all threads finished their warmup and the time of all
+   threads is measured from that signal, so that the timed windows overlap
+   even if there are less CPUs than threads.
+\* ------------------------------------------------------------------------- */
+static void scale_run(SCALE_JOB * pj)
+{
+   const BENCH_INPUT * pin = pj->pin;
+   uint64_t            sum = 0;
+   int                 i;
+
+   for(i = 0; i < pj->popt->warmup; ++i)
+      sum += pj->pf->loop(pin->pps, pin->count, pin->base);
+
+   SCALE_INC(pj->pready);
+
+   if(pj->wait)
+   {
+      while(SCALE_LOAD(pj->pready) < pj->wait)
+         ;
+      pj->t0 = bench_ns();
+      SCALE_STORE(pj->pgo, 1);
+   }
+   else
+   {
+      while(!SCALE_LOAD(pj->pgo))
+         ;
+   }
+
+   for(i = 0; i < pj->popt->trials; ++i)
+      sum += pj->pf->loop(pin->pps, pin->count, pin->base);
+
+   pj->t1  = bench_ns();
+   pj->sum = sum;
+}/* void scale_run(SCALE_JOB * pj) */
+
+#if defined (_WIN32)
+static unsigned __stdcall scale_thread(void * pv)
+{
+   scale_run((SCALE_JOB *) pv);
+   return (0);
+}/* unsigned __stdcall scale_thread(void * pv) */
+#else
+static void * scale_thread(void * pv)
+{
+   scale_run((SCALE_JOB *) pv);
+   return (NULL);
+}/* void * scale_thread(void * pv) */
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   scale_measure runs a function on threads threads over the same input.
+   ns_median and ns_mean are the nanoseconds per value of a thread,
+   ns_stddev is their deviation between the threads and mb_s is the
+   aggregate throughput of all threads.
+\* ------------------------------------------------------------------------- */
+static int scale_measure(const BENCH_FUNC * pf, const BENCH_INPUT * pin, const BENCH_OPT * popt, int threads, BENCH_RESULT * pr)
+{
+   SCALE_JOB *  pjob = (SCALE_JOB *) calloc((size_t) threads, sizeof(SCALE_JOB));
+#if defined (_WIN32)
+   HANDLE *     pth  = (HANDLE *) calloc((size_t) threads, sizeof(HANDLE));
+#else
+   pthread_t *  pth  = (pthread_t *) calloc((size_t) threads, sizeof(pthread_t));
+#endif
+   double *     pns  = (double *) calloc((size_t) threads, sizeof(double));
+   SCALE_ATOMIC ready;
+   SCALE_ATOMIC go;
+   uint64_t     t0   = 0;
+   uint64_t     t1   = 0;
+   double       sum  = 0.0;
+   double       sq   = 0.0;
+   double       values;
+   int          bret = 0;
+   int          started;
+   int          i;
+
+   memset(pr, 0, sizeof(*pr));
+   for(i = 0; i < BENCH_COUNTERS; ++i)
+      pr->counter[i] = -1.0;
+
+   if(!pjob || !pth || !pns)
+      goto Exit;
+
+   SCALE_STORE(&ready, 0);
+   SCALE_STORE(&go, 0);
+
+   for(i = 0; i < threads; ++i)
+   {
+      pjob[i].pf     = pf;
+      pjob[i].pin    = pin;
+      pjob[i].popt   = popt;
+      pjob[i].pready = &ready;
+      pjob[i].pgo    = &go;
+   }
+
+   for(started = 1; started < threads; ++started)
+   {
+#if defined (_WIN32)
+      pth[started] = (HANDLE) _beginthreadex(NULL, 0, scale_thread, pjob + started, 0, NULL);
+      if(!pth[started])
+         break;
+#else
+      if(pthread_create(pth + started, NULL, scale_thread, pjob + started))
+         break;
+#endif
+   }
+
+   pjob[0].wait = started; /* the main thread releases the started threads */
+   scale_run(pjob);
+
+   for(i = 1; i < started; ++i)
+   {
+#if defined (_WIN32)
+      WaitForSingleObject(pth[i], INFINITE);
+      CloseHandle(pth[i]);
+#else
+      pthread_join(pth[i], NULL);
+#endif
+   }
+
+   if(started < threads)
+   {
+      sfprintf(stderr, "Can't start %d threads!\n", threads);
+      goto Exit;
+   }
+
+   values = (double) pin->count * popt->trials;
+
+   t0 = pjob[0].t0;
+
+   for(i = 0; i < threads; ++i)
+   {
+      if(pjob[i].t1 > t1)
+         t1 = pjob[i].t1;
+
+      pns[i]      = (double) (pjob[i].t1 - t0) / values;
+      sum        += pns[i];
+      sq         += pns[i] * pns[i];
+      bench_sink = bench_sink + pjob[i].sum;
+   }
+
+   qsort(pns, (size_t) threads, sizeof(double), cmp_double);
+
+   pr->trials    = threads;
+   pr->ns_median = percentile(pns, (size_t) threads, 0.5);
+   pr->ns_p99    = percentile(pns, (size_t) threads, 0.99);
+   pr->ns_mean   = sum / threads;
+   pr->ns_stddev = (threads > 1) ? bench_sqrt((sq - sum * pr->ns_mean) / (threads - 1)) : 0.0;
+   pr->mb_s      = (t1 > t0) ? (double) pin->bytes * popt->trials * threads * 1000.0 / (double) (t1 - t0) : 0.0;
+
+   bret = 1;
+
+Exit:;
+
+   if(pjob)
+      free(pjob);
+   if(pth)
+      free(pth);
+   if(pns)
+      free(pns);
+
+   return (bret);
+}/* int scale_measure(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   scale_input runs all selected functions that match the kind of an input
+   on 1, 2, 4, ... and popt->threads threads and prints the aggregate
+   throughput and the efficiency of the threads compared to a single one
+\* ------------------------------------------------------------------------- */
+static int scale_input(const BENCH_INPUT * pin, const BENCH_OPT * popt)
+{
+   size_t i;
+
+   for(i = 0; i < ARRAY_SIZE(bench_funcs); ++i)
+   {
+      const BENCH_FUNC * pf     = &bench_funcs[i];
+      double             single = 0.0;
+      int                threads;
+
+      if(!(pf->kind & pin->kind) || !name_selected(popt->pfuncs ? popt->pfuncs : SCALE_FUNCS, pf->name))
+         continue;
+
+      for(threads = 1; threads <= popt->threads; threads = (threads < popt->threads && 2 * threads > popt->threads) ? popt->threads : 2 * threads)
+      {
+         BENCH_RESULT r;
+         char         name[64];
+         double       mvalues;
+
+         if(!scale_measure(pf, pin, popt, threads, &r))
+            return (0);
+
+         mvalues = (r.mb_s > 0.0) ? r.mb_s * (double) pin->count / (double) pin->bytes : 0.0;
+
+         if(threads == 1)
+            single = mvalues;
+
+         sfprintf(stdout, "%-14s %-10s %7d %9.2f %8.2f %9.1f %9.1f %9.1f%%\n", pf->name, pin->name, threads,
+                  r.ns_median, r.ns_stddev, mvalues, r.mb_s, (single > 0.0) ? mvalues * 100.0 / (single * threads) : 0.0);
+
+         ssprintf(name, "%.48s/%dt", pin->name, threads);
+         if(!record_add(pf->name, name, &r))
+            return (0);
+      }
+   }
+
+   return (1);
+}/* int scale_input(const BENCH_INPUT * pin, const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   Latency benchmark
+\* ------------------------------------------------------------------------- */
+
+static volatile uint8_t * pevict      = NULL; /* buffer that is read for evicting the caches */
+static size_t             evict_size  = 0;    /* size of the buffer */
+
+/* ------------------------------------------------------------------------- *\
+   evict_caches reads a cache line of every 64 bytes of the eviction buffer
+   that should be larger than the last level cache
+\* ------------------------------------------------------------------------- */
+static void evict_caches()
+{
+   uint64_t sum = 0;
+   size_t   i;
+
+   for(i = 0; i < evict_size; i += 64)
+      sum += pevict[i];
+
+   bench_sink = bench_sink + sum;
+}/* void evict_caches() */
+
+
+/* ------------------------------------------------------------------------- *\
+   latency_measure measures popt->latency single calls of a function after
+   evicting the caches each time. The median overhead of the timers is
+   subtracted from the results. ns_median and cyc_median are the 50th
+   percentiles and the other percentiles are returned in pns[4] and pcyc[4].
+\* ------------------------------------------------------------------------- */
+static int latency_measure(const BENCH_FUNC * pf, const BENCH_INPUT * pin, const BENCH_OPT * popt,
+                           BENCH_RESULT * pr, double * pns, double * pcyc)
+{
+   static const double pct[4] = { 0.5, 0.9, 0.99, 0.999 };
+
+   size_t   samples = (size_t) popt->latency;
+   double * pt      = (double *) malloc(samples * sizeof(double));
+   double * pc      = (double *) malloc(samples * sizeof(double));
+   double   ns_overhead;
+   double   cyc_overhead;
+   double   sum     = 0.0;
+   double   sq      = 0.0;
+   size_t   i;
+
+   memset(pr, 0, sizeof(*pr));
+   for(i = 0; i < BENCH_COUNTERS; ++i)
+      pr->counter[i] = -1.0;
+
+   if(!pt || !pc)
+   {
+      if(pt)
+         free(pt);
+      if(pc)
+         free(pc);
+      return (0);
+   }
+
+   /* overhead of the timers without any call in between */
+   for(i = 0; i < samples; ++i)
+   {
+      uint64_t c0 = bench_cycles();
+      uint64_t t0 = bench_ns();
+      uint64_t t1 = bench_ns();
+      uint64_t c1 = bench_cycles();
+
+      pt[i] = (double) (t1 - t0);
+      pc[i] = (double) (c1 - c0);
+   }
+
+   qsort(pt, samples, sizeof(double), cmp_double);
+   qsort(pc, samples, sizeof(double), cmp_double);
+   ns_overhead  = percentile(pt, samples, 0.5);
+   cyc_overhead = percentile(pc, samples, 0.5);
+
+   for(i = 0; i < samples; ++i)
+   {
+      char * const * pps = &pin->pps[i % pin->count];
+      uint64_t       c0;
+      uint64_t       t0;
+      uint64_t       t1;
+      uint64_t       c1;
+
+      evict_caches();
+
+      c0 = bench_cycles();
+      t0 = bench_ns();
+
+      bench_sink = bench_sink + pf->loop(pps, 1, pin->base);
+
+      t1 = bench_ns();
+      c1 = bench_cycles();
+
+      pt[i] = (double) (t1 - t0) - ns_overhead;
+      pc[i] = (double) (c1 - c0) - cyc_overhead;
+
+      if(pt[i] < 0.0)
+         pt[i] = 0.0;
+      if(pc[i] < 0.0)
+         pc[i] = 0.0;
+
+      sum += pt[i];
+      sq  += pt[i] * pt[i];
+   }
+
+   qsort(pt, samples, sizeof(double), cmp_double);
+   qsort(pc, samples, sizeof(double), cmp_double);
+
+   for(i = 0; i < 4; ++i)
+   {
+      pns[i]  = percentile(pt, samples, pct[i]);
+      pcyc[i] = percentile(pc, samples, pct[i]);
+   }
+
+   pr->trials     = popt->latency;
+   pr->ns_median  = pns[0];
+   pr->ns_p99     = pns[2];
+   pr->ns_mean    = sum / (double) samples;
+   pr->ns_stddev  = (samples > 1) ? bench_sqrt((sq - sum * pr->ns_mean) / (double) (samples - 1)) : 0.0;
+   pr->cyc_median = pcyc[0];
+   pr->mb_s       = (pr->ns_median > 0.0) ? ((double) pin->bytes / (double) pin->count) * 1000.0 / pr->ns_median : 0.0;
+
+   free(pt);
+   free(pc);
+
+   return (1);
+}/* int latency_measure(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   latency_input runs all selected functions that match the kind of an input
+   in the latency mode
+\* ------------------------------------------------------------------------- */
+static int latency_input(const BENCH_INPUT * pin, const BENCH_OPT * popt)
+{
+   size_t i;
+
+   for(i = 0; i < ARRAY_SIZE(bench_funcs); ++i)
+   {
+      const BENCH_FUNC * pf = &bench_funcs[i];
+      BENCH_RESULT       r;
+      double             ns[4];
+      double             cyc[4];
+
+      if(!(pf->kind & pin->kind) || !name_selected(popt->pfuncs, pf->name))
+         continue;
+
+      if(!latency_measure(pf, pin, popt, &r, ns, cyc))
+         return (0);
+
+      sfprintf(stdout, "%-14s %-10s %8.1f %8.1f %8.1f %8.1f  %8.0f %8.0f %8.0f %8.0f\n", pf->name, pin->name,
+               ns[0], ns[1], ns[2], ns[3], cyc[0], cyc[1], cyc[2], cyc[3]);
+
+      if(!record_add(pf->name, pin->name, &r))
+         return (0);
+   }
+
+   return (1);
+}/* int latency_input(const BENCH_INPUT * pin, const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   bench_input runs all selected functions that match the kind of an input
+\* ------------------------------------------------------------------------- */
+static int bench_input(const BENCH_INPUT * pin, const BENCH_OPT * popt)
+{
+   size_t i;
+
+   if(popt->threads)
+      return (scale_input(pin, popt));
+
+   if(popt->latency)
+      return (latency_input(pin, popt));
+
+   for(i = 0; i < ARRAY_SIZE(bench_funcs); ++i)
+   {
+      const BENCH_FUNC * pf = &bench_funcs[i];
+      BENCH_RESULT       r;
+
+      if(!(pf->kind & pin->kind) || !name_selected(popt->pfuncs, pf->name))
+         continue;
+
+      if(!bench_measure(pf, pin, popt, &r))
+         return (0);
+
+      print_result(pf->name, pin->name, &r, popt);
+
+      if(!record_add(pf->name, pin->name, &r))
+         return (0);
+   }
+
+   return (1);
+}/* int bench_input(const BENCH_INPUT * pin, const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   run_bench runs the benchmarks of all selected functions and input classes.
+   It returns 0 in case of errors, 2 in case of regressions and 1 otherwise.
+\* ------------------------------------------------------------------------- */
+int run_bench(const BENCH_OPT * popt)
+{
+   size_t i;
+
+   if(popt->perf)
+      perf_open();
+
+   if(popt->latency && popt->evict_mb)
+   {
+      evict_size = (size_t) popt->evict_mb << 20;
+      pevict     = (volatile uint8_t *) malloc(evict_size);
+
+      if(!pevict)
+         return (0);
+
+      /* Pages that were never written may share a single physical page. */
+      memset((void *) pevict, 1, evict_size);
+   }
+
+   print_header(popt);
+
+   for(i = 0; i < (size_t) popt->files; ++i)
+   {
+      BENCH_INPUT in;
+      int         ok;
+
+      if(!input_load(&in, popt->pfile[i], popt->base))
+         return (0);
+
+      ok = bench_input(&in, popt);
+      input_free(&in);
+
+      if(!ok)
+         return (0);
+   }
+
+   for(i = 0; i < ARRAY_SIZE(bench_classes); ++i)
+   {
+      const char * pclasses = popt->pclasses;
+      BENCH_INPUT  in;
+      int          ok;
+
+      if(!pclasses && popt->threads)
+         pclasses = SCALE_CLASSES;
+
+      /* The generated inputs are skipped for data files unless they are selected explicitly. */
+      if((popt->files && !popt->pclasses) || !name_selected(pclasses, bench_classes[i].name))
+         continue;
+
+      if(!input_generate(&in, &bench_classes[i], popt->count))
+         return (0);
+
+      ok = bench_input(&in, popt);
+      input_free(&in);
+
+      if(!ok)
+         return (0);
+   }
+
+   if(popt->pout && !write_results(popt->pout, popt))
+      return (0);
+
+   if(popt->pbaseline)
+   {
+      int regressions = compare_results(popt->pbaseline, popt->threshold);
+
+      if(regressions < 0)
+         return (0);
+      if(regressions)
+         return (2);
+   }
+
+   return (1);
+}/* int run_bench(const BENCH_OPT * popt) */
+
+
+/* ------------------------------------------------------------------------- *\
+   bench_list prints the names of the functions and the input classes
+\* ------------------------------------------------------------------------- */
+void bench_list()
+{
+   size_t i;
+
+   sfprintf(stdout, "functions:\n");
+   for(i = 0; i < ARRAY_SIZE(bench_funcs); ++i)
+      sfprintf(stdout, "   %-14s %s\n", bench_funcs[i].name, (bench_funcs[i].kind == BK_ANY) ? "any" : (bench_funcs[i].kind == BK_INT) ? "integer" : "floating point");
+
+   sfprintf(stdout, "input classes:\n");
+   for(i = 0; i < ARRAY_SIZE(bench_classes); ++i)
+      sfprintf(stdout, "   %-14s %s (base %d)\n", bench_classes[i].name, bench_classes[i].desc, bench_classes[i].base);
+}/* void bench_list() */
+
+
+/* ------------------------------------------------------------------------- *\
+   usage prints the command line options
+\* ------------------------------------------------------------------------- */
+void usage(const char * pname)
+{
+   sfprintf(stderr,
+            "usage: %s [options]\n"
+            "  -f list   benchmark only the comma separated functions (a trailing * matches prefixes)\n"
+            "  -c list   benchmark only the comma separated input classes\n"
+            "  -d file   benchmark the numbers of a file with one number per line (repeatable)\n"
+            "  -B base   numeric base of the numbers of the files (default 10)\n"
+            "  -p        read the hardware performance counters (Linux only)\n"
+            "  -o file   write the results into a JSON file or a CSV file if the name ends with .csv\n"
+            "  -C file   compare the results with a JSON or CSV file of a previous run and\n"
+            "            exit with 3 if any function got significantly slower\n"
+            "  -r pct    minimum slowdown in percent of a regression (default 5)\n"
+            "  -T count  run the scaling benchmark on 1, 2, 4, ... up to count threads instead\n"
+            "  -L count  measure the latency of count single calls with cold caches instead\n"
+            "  -E MB     size of the buffer for evicting the caches of -L (default 32, 0 keeps them warm)\n"
+            "  -n count  number of strings of each input (default 10000)\n"
+            "  -t count  number of timed trials (default 31)\n"
+            "  -w count  number of warmup runs (default 5)\n"
+            "  -l        list the functions and input classes\n"
+            "  -b        run the benchmarks only and skip the tests\n"
+            "  -s        run the tests only and skip the benchmarks\n",
+            pname);
+}/* void usage(const char * pname) */
+
+
+#ifndef BENCH_SUITE_ONLY
+
+/* ------------------------------------------------------------------------- *\
+   main function
+\* ------------------------------------------------------------------------- */
+int main(int argc, char * argv[])
+{
+    int       iret  = 1;
+    int       tests = 1;
+    int       bench = 1;
+    int       i;
+    BENCH_OPT opt;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.count  = 10000;
+    opt.trials = 31;
+    opt.warmup = 5;
+    opt.base   = 10;
+    opt.threshold = 5.0;
+    opt.evict_mb  = 32;
+
+    for(i = 1; i < argc; ++i)
+    {
+        const char * popt = argv[i];
+        const char * parg = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if(!strcmp(popt, "-l"))
+        {
+            bench_list();
+            return (0);
+        }
+        else if(!strcmp(popt, "-b"))
+            tests = 0;
+        else if(!strcmp(popt, "-s"))
+            bench = 0;
+        else if(!strcmp(popt, "-p"))
+            opt.perf = 1;
+        else if(parg && !strcmp(popt, "-f"))
+            opt.pfuncs = argv[++i];
+        else if(parg && !strcmp(popt, "-c"))
+            opt.pclasses = argv[++i];
+        else if(parg && !strcmp(popt, "-d") && (opt.files < BENCH_MAX_FILES))
+            opt.pfile[opt.files++] = argv[++i];
+        else if(parg && !strcmp(popt, "-B"))
+            opt.base = str2i32(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-o"))
+            opt.pout = argv[++i];
+        else if(parg && !strcmp(popt, "-C"))
+            opt.pbaseline = argv[++i];
+        else if(parg && !strcmp(popt, "-r"))
+            opt.threshold = str2d(argv[++i], NULL);
+        else if(parg && !strcmp(popt, "-T"))
+            opt.threads = str2i32(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-L"))
+            opt.latency = str2i32(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-E"))
+            opt.evict_mb = str2i32(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-n"))
+            opt.count = (size_t) str2sz(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-t"))
+            opt.trials = str2i32(argv[++i], NULL, 10);
+        else if(parg && !strcmp(popt, "-w"))
+            opt.warmup = str2i32(argv[++i], NULL, 10);
+        else
+        {
+            usage(argv[0]);
+            return (2);
+        }
+    }
+
+    if(!opt.count || (opt.trials < 1) || (opt.warmup < 0) || (opt.threads < 0) || (opt.latency < 0) || (opt.evict_mb < 0) || (opt.evict_mb > 4096) || (opt.base < 0) || (opt.base == 1) || (opt.base > 36))
+    {
+        usage(argv[0]);
+        return (2);
+    }
+
+    if(tests)
+    {
+        if(!test_base_detection())
+            goto Exit;
+
+        if(!test_str2value())
+            goto Exit;
+
+        if(!test_batch())
+            goto Exit;
+
+        if(!test_file())
+            goto Exit;
+
+        if(!test_stats())
+            goto Exit;
+
+        if(!test_ret())
+            goto Exit;
+
+        if(!test_lazy())
+            goto Exit;
+
+        if(!test_any())
+            goto Exit;
+
+        if(!run_tests())
+            goto Exit;
+
+        if(!run_float_tests())
+            goto Exit;
+
+        sfprintf(stdout, "All tests passed!\n");
+    }
+
+    if(bench)
+    {
+        int r = run_bench(&opt);
+
+        if(!r)
+            goto Exit;
+
+        if(r == 2)
+        {
+            iret = 3; /* regressions */
+            goto Exit;
+        }
+    }
+
+    iret = 0;
+
+    Exit:;
+
+    if(iret == 1)
+        sfprintf(stderr, "Tests failed!\n");
+
+    return (iret);
+}/* main() */
+
+#endif /* BENCH_SUITE_ONLY */
 
 
 /* ========================================================================= *\
@@ -0,0 +1,181 @@
+#if 0
+rm -f ./_cache_str2num
+cc -Wall -O3 -o _cache_str2num -I . cache_str2num.c str2num.c str2num_batch.c str2num_file.c -lpthread
+exit $?
+#endif
+
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    cache_str2num.c                                              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : tool for the cache files of str2num_file.c                   *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <str2num_file.h>
+
+/* names of the column types */
+static const char * const type_name[] = { "", "i8", "u8", "i16", "u16", "i32", "u32", "i64", "u64", "f32", "f64" };
+
+
+/* ------------------------------------------------------------------------- *\
+   usage prints the usage of the tool.
+\* ------------------------------------------------------------------------- */
+
+static void usage(const char * pname)
+{
+   fprintf(stderr,
+           "usage: %s [-t type] [-b base] [-d delimiter] [-o cache] [-c] [-v] source...\n"
+           "  -t  type of the values i8, u8, i16, u16, i32, u32, i64, u64, f32 or f64 (default f64)\n"
+           "  -b  numeric base of the values (default 10, 0 for autodetection)\n"
+           "  -d  delimiter of the values, \\t for tabs (default \\n)\n"
+           "  -o  name of the cache file if there is just one source (default source.s2n)\n"
+           "  -c  check the cache files only instead of building them\n"
+           "  -v  verify the checksum of the sources too\n",
+           pname);
+} /* void usage(const char * pname) */
+
+
+/* ------------------------------------------------------------------------- *\
+   main function
+\* ------------------------------------------------------------------------- */
+
+int main(int argc, char * argv[])
+{
+   int          iret   = 0;
+   int          type   = S2N_COL_F64;
+   int          base   = 10;
+   char         delim  = '\n';
+   int          check  = 0;
+   int          flags  = 0;
+   const char * pcache = NULL;
+   int          i;
+
+   for(i = 1; (i < argc) && (argv[i][0] == '-') && argv[i][1]; ++i)
+   {
+      const char * popt = argv[i];
+
+      if(!strcmp(popt, "-c"))
+      {
+         check = 1;
+      }
+      else if(!strcmp(popt, "-v"))
+      {
+         flags |= S2N_CACHE_VERIFY;
+      }
+      else if((i + 1 < argc) && !strcmp(popt, "-t"))
+      {
+         for(type = S2N_COL_F64; type; --type)
+         {
+            if(!strcmp(argv[i + 1], type_name[type]))
+               break;
+         }
+
+         if(!type)
+         {
+            usage(argv[0]);
+            return (2);
+         }
+         ++i;
+      }
+      else if((i + 1 < argc) && !strcmp(popt, "-b"))
+      {
+         base = (int) str2i32(argv[++i], NULL, 10);
+      }
+      else if((i + 1 < argc) && !strcmp(popt, "-d"))
+      {
+         ++i;
+         delim = strcmp(argv[i], "\\t") ? argv[i][0] : '\t';
+      }
+      else if((i + 1 < argc) && !strcmp(popt, "-o"))
+      {
+         pcache = argv[++i];
+      }
+      else
+      {
+         usage(argv[0]);
+         return (2);
+      }
+   }
+
+   if((i >= argc) || (pcache && (i + 1 < argc)))
+   {
+      usage(argv[0]);
+      return (2);
+   }
+
+   for(; i < argc; ++i)
+   {
+      s2n_cache c;
+      int       err;
+
+      if(check)
+      {
+         err = str2cache_open(&c, argv[i], pcache, 0, flags);
+         if(err == S2N_ESTALE)
+         {
+            printf("%s: outdated\n", argv[i]);
+            iret = 1;
+            continue;
+         }
+      }
+      else
+      {
+         err = str2cache_build(argv[i], pcache, type, base, delim);
+         if(!err)
+            err = str2cache_open(&c, argv[i], pcache, type, 0);
+      }
+
+      if(err)
+      {
+         fprintf(stderr, "%s: %s\n", argv[i], strerror(err));
+         iret = 1;
+         continue;
+      }
+
+      printf("%s: %llu %s values, %llu null values, %llu errors\n", argv[i], (unsigned long long) c.count,
+             type_name[c.type], (unsigned long long) c.null_count, (unsigned long long) c.errors);
+
+      str2cache_close(&c);
+   }
+
+   return (iret);
+} /* main() */
+
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
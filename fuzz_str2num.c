@@ -0,0 +1,491 @@
+#if 0
+rm -f ./_fuzz_str2num
+cc -Wall -O1 -g -fsanitize=address,undefined -DFUZZ_MAIN -o _fuzz_str2num -I . fuzz_str2num.c str2num.c
+./_fuzz_str2num fuzz_corpus/seed_*
+exit $?
+#endif
+
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    fuzz_str2num.c                                               *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : differential fuzzer of the str2num functions                 *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+/* The fuzzer checks all functions of str2num.c with arbitrary strings and bases against
+   each other and against the C library.
+
+   libFuzzer: clang -g -O1 -fsanitize=fuzzer,address,undefined -I . fuzz_str2num.c str2num.c
+              ./a.out fuzz_corpus
+
+   AFL:       afl-clang-fast -g -O1 -DFUZZ_MAIN -I . fuzz_str2num.c str2num.c
+              afl-fuzz -i fuzz_corpus -o fuzz_out ./a.out @@
+
+   The first byte of an input selects the numeric base and the other bytes are the string. */
+
+
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <str2num.h>
+
+/* maximum distance of floating point values in units in the last place */
+#ifndef FUZZ_MAX_ULP
+#define FUZZ_MAX_ULP 16
+#endif
+
+#define IS_BLANK(c) (((c) == ' ') || (((c) >= 0x9) && ((c) <= 0xd)))
+
+/* ------------------------------------------------------------------------- *\
+   fuzz_fail reports a difference and aborts for the fuzzer
+\* ------------------------------------------------------------------------- */
+
+static void fuzz_fail(const char * pfn, const char * ps, int base, const char * what)
+{
+   fprintf(stderr, "%s: different %s for base %d and string \"", pfn, what, base);
+
+   for(; *ps; ++ps)
+   {
+      if(((uint8_t) *ps < ' ') || ((uint8_t) *ps >= 0x7f) || (*ps == '"') || (*ps == '\\'))
+         fprintf(stderr, "\\x%02x", (uint8_t) *ps);
+      else
+         fputc(*ps, stderr);
+   }
+
+   fprintf(stderr, "\"!\n");
+   abort();
+} /* void fuzz_fail(const char * pfn, const char * ps, int base, const char * what) */
+
+
+/* ------------------------------------------------------------------------- *\
+   fuzz_check calls fuzz_fail if any of the results differ
+\* ------------------------------------------------------------------------- */
+
+static void fuzz_check(const char * pfn, const char * ps, int base, int value_ok, int end_ok, int err_ok)
+{
+   if(!value_ok)
+      fuzz_fail(pfn, ps, base, "value");
+   if(!end_ok)
+      fuzz_fail(pfn, ps, base, "end");
+   if(!err_ok)
+      fuzz_fail(pfn, ps, base, "error");
+} /* void fuzz_check(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   ulp_distance returns the distance of two doubles in units in the last
+   place. NaN values of the same sign have a distance of 0.
+\* ------------------------------------------------------------------------- */
+
+static uint64_t ulp_distance(double a, double b)
+{
+   int64_t ia;
+   int64_t ib;
+
+   if((a != a) || (b != b))
+      return (((a != a) && (b != b)) ? 0 : UINT64_MAX);
+
+   memcpy(&ia, &a, sizeof(ia));
+   memcpy(&ib, &b, sizeof(ib));
+
+   /* map the sign magnitude representation to a monotonic one */
+   ia = (ia < 0) ? INT64_MIN - ia : ia;
+   ib = (ib < 0) ? INT64_MIN - ib : ib;
+
+   return ((ia > ib) ? (uint64_t) ia - (uint64_t) ib : (uint64_t) ib - (uint64_t) ia);
+} /* uint64_t ulp_distance(double a, double b) */
+
+
+/* ------------------------------------------------------------------------- *\
+   ref_signed and ref_unsigned call the fixed size conversion of the size of
+   a native type
+\* ------------------------------------------------------------------------- */
+
+static int64_t ref_signed(size_t size, const char * ps, char ** pe, int base, int * perr)
+{
+   switch(size)
+   {
+      case 1:  return (str2i8_r (ps, pe, base, perr));
+      case 2:  return (str2i16_r(ps, pe, base, perr));
+      case 4:  return (str2i32_r(ps, pe, base, perr));
+      default: return (str2i64_r(ps, pe, base, perr));
+   }
+} /* int64_t ref_signed(...) */
+
+static uint64_t ref_unsigned(size_t size, const char * ps, char ** pe, int base, int * perr)
+{
+   switch(size)
+   {
+      case 1:  return (str2u8_r (ps, pe, base, perr));
+      case 2:  return (str2u16_r(ps, pe, base, perr));
+      case 4:  return (str2u32_r(ps, pe, base, perr));
+      default: return (str2u64_r(ps, pe, base, perr));
+   }
+} /* uint64_t ref_unsigned(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   checks of the integer conversions
+\* ------------------------------------------------------------------------- */
+
+/* A signed type of less than 64 bits returns the clamped value of str2i64_r. */
+#define CHECK_SIGNED(fn, T, MIN, MAX)                                                   \
+   {                                                                                  \
+      char *  pe   = NULL;                                                            \
+      int     err  = -1;                                                              \
+      T       v    = fn(ps, &pe, base, &err);                                         \
+      int64_t x    = i64;                                                             \
+      int     xerr = ei64;                                                            \
+                                                                                      \
+      if((xerr == ERANGE) || (!xerr && ((x < (MIN)) || (x > (MAX)))))                 \
+      {                                                                               \
+         x    = (x < 0) ? (MIN) : (MAX);                                              \
+         xerr = ERANGE;                                                               \
+      }                                                                               \
+      fuzz_check(#fn, ps, base, (int64_t) v == x, pe == pei64, err == xerr);           \
+   }
+
+/* An unsigned type of less than 64 bits returns the value of str2u64_r in its own range.
+   Negative numbers are negated in the unsigned type like strtoul does if their magnitude
+   fits into the type. */
+#define CHECK_UNSIGNED(fn, T, MAX)                                                      \
+   {                                                                                  \
+      char *   pe   = NULL;                                                           \
+      int      err  = -1;                                                             \
+      T        v    = fn(ps, &pe, base, &err);                                        \
+      uint64_t x    = u64;                                                            \
+      int      xerr = eu64;                                                           \
+                                                                                      \
+      if(xerr == ERANGE)                                                              \
+         x = (MAX);                                                                   \
+      else if(!xerr && neg && !S2N_UMIN_IS_SMIN)                                       \
+      {                                                                               \
+         if(0 - x > (MAX))                                                            \
+         {                                                                            \
+            x    = (MAX);                                                             \
+            xerr = ERANGE;                                                            \
+         }                                                                            \
+         else                                                                         \
+            x = (T) x;                                                                \
+      }                                                                               \
+      else if(!xerr && (x > (MAX)))                                                   \
+      {                                                                               \
+         x    = (MAX);                                                                \
+         xerr = ERANGE;                                                               \
+      }                                                                               \
+      if(!neg || !S2N_UMIN_IS_SMIN)                                                   \
+         fuzz_check(#fn, ps, base, (uint64_t) v == x, pe == peu64, err == xerr);       \
+   }
+
+/* A native type returns the same as the fixed size function of its size. */
+#define CHECK_NATIVE(fn, T, ref)                                                        \
+   {                                                                                  \
+      char * pe   = NULL;                                                             \
+      char * pex  = NULL;                                                             \
+      int    err  = -1;                                                               \
+      int    xerr = -1;                                                               \
+      T      v    = fn(ps, &pe, base, &err);                                          \
+      T      x    = (T) ref(sizeof(T), ps, &pex, base, &xerr);                        \
+      fuzz_check(#fn, ps, base, v == x, pe == pex, err == xerr);                      \
+   }
+
+/* The wrappers that set errno return the same as the reentrant functions. */
+#define CHECK_ERRNO(fn, fn_r, T)                                                        \
+   {                                                                                  \
+      char * pe   = NULL;                                                             \
+      char * pex  = NULL;                                                             \
+      int    xerr = 0;                                                                \
+      T      x    = fn_r(ps, &pex, base, &xerr);                                      \
+      T      v;                                                                       \
+      errno = 0;                                                                      \
+      v     = fn(ps, &pe, base);                                                      \
+      fuzz_check(#fn, ps, base, v == x, pe == pex, errno == xerr);                    \
+   }
+
+static void fuzz_integers(const char * ps, int base)
+{
+   const char * pb   = ps;
+   char *       pei64 = NULL;
+   char *       peu64 = NULL;
+   int          ei64 = 0;
+   int          eu64 = 0;
+   int64_t      i64  = str2i64_r(ps, &pei64, base, &ei64);
+   uint64_t     u64  = str2u64_r(ps, &peu64, base, &eu64);
+   int          neg;
+
+   while(IS_BLANK(*pb))
+      ++pb;
+   neg = (*pb == '-');
+
+   /* The signed and unsigned conversions accept the same strings. */
+   fuzz_check("str2u64_r", ps, base, 1, peu64 == pei64, (eu64 == EINVAL) == (ei64 == EINVAL));
+
+   CHECK_SIGNED  (str2i32_r, int32_t, INT32_MIN, INT32_MAX)
+   CHECK_SIGNED  (str2i16_r, int16_t, INT16_MIN, INT16_MAX)
+   CHECK_SIGNED  (str2i8_r,  int8_t,  INT8_MIN,  INT8_MAX)
+   CHECK_UNSIGNED(str2u32_r, uint32_t, UINT32_MAX)
+   CHECK_UNSIGNED(str2u16_r, uint16_t, UINT16_MAX)
+   CHECK_UNSIGNED(str2u8_r,  uint8_t,  UINT8_MAX)
+
+   CHECK_NATIVE(str2pd_r,  ptrdiff_t,          ref_signed)
+   CHECK_NATIVE(str2sz_r,  size_t,             ref_unsigned)
+   CHECK_NATIVE(str2ip_r,  intptr_t,           ref_signed)
+   CHECK_NATIVE(str2up_r,  uintptr_t,          ref_unsigned)
+   CHECK_NATIVE(str2i_r,   int,                ref_signed)
+   CHECK_NATIVE(str2u_r,   unsigned int,       ref_unsigned)
+   CHECK_NATIVE(str2l_r,   long,               ref_signed)
+   CHECK_NATIVE(str2ul_r,  unsigned long,      ref_unsigned)
+   CHECK_NATIVE(str2ll_r,  long long,          ref_signed)
+   CHECK_NATIVE(str2ull_r, unsigned long long, ref_unsigned)
+
+   CHECK_ERRNO(str2i64, str2i64_r, int64_t)
+   CHECK_ERRNO(str2u64, str2u64_r, uint64_t)
+   CHECK_ERRNO(str2i32, str2i32_r, int32_t)
+   CHECK_ERRNO(str2u32, str2u32_r, uint32_t)
+   CHECK_ERRNO(str2i16, str2i16_r, int16_t)
+   CHECK_ERRNO(str2u16, str2u16_r, uint16_t)
+   CHECK_ERRNO(str2i8,  str2i8_r,  int8_t)
+   CHECK_ERRNO(str2u8,  str2u8_r,  uint8_t)
+   CHECK_ERRNO(str2pd,  str2pd_r,  ptrdiff_t)
+   CHECK_ERRNO(str2sz,  str2sz_r,  size_t)
+   CHECK_ERRNO(str2ip,  str2ip_r,  intptr_t)
+   CHECK_ERRNO(str2up,  str2up_r,  uintptr_t)
+   CHECK_ERRNO(str2i,   str2i_r,   int)
+   CHECK_ERRNO(str2u,   str2u_r,   unsigned int)
+   CHECK_ERRNO(str2l,   str2l_r,   long)
+   CHECK_ERRNO(str2ul,  str2ul_r,  unsigned long)
+   CHECK_ERRNO(str2ll,  str2ll_r,  long long)
+   CHECK_ERRNO(str2ull, str2ull_r, unsigned long long)
+
+   /* The C library doesn't know the base 1 and may not know the prefixes 0b and 0o. */
+   if((base != 1) && (base <= 36) && !(((base == 0) || (base == 2) || (base == 8)) && strpbrk(ps, "bBoO")))
+   {
+      char *             pe;
+      long long          ll;
+      unsigned long long ull;
+
+      errno = 0;
+      ll    = strtoll(ps, &pe, base);
+      fuzz_check("strtoll", ps, base, (int64_t) ll == i64, pe == pei64, (errno == ERANGE) == (ei64 == ERANGE));
+
+      errno = 0;
+      ull   = strtoull(ps, &pe, base);
+      if(!neg || !S2N_UMIN_IS_SMIN)
+         fuzz_check("strtoull", ps, base, (uint64_t) ull == u64, pe == peu64, (errno == ERANGE) == (eu64 == ERANGE));
+   }
+} /* void fuzz_integers(const char * ps, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   checks of the floating point conversions
+\* ------------------------------------------------------------------------- */
+
+static void fuzz_floats(const char * ps, int base)
+{
+   char *      pe   = NULL;
+   char *      pel  = NULL;
+   char *      pex  = NULL;
+   int         err  = -1;
+   int         errl = -1;
+   double      d    = str2d_r(ps, &pe, base, &err);
+   long double ld   = str2ld_r(ps, &pel, base, &errl);
+
+   /* The long double conversion rounded to a double differs just by a few units in the last place. */
+   fuzz_check("str2ld_r", ps, base, ulp_distance(d, (double) ld) <= FUZZ_MAX_ULP, pe == pel, err == errl);
+
+   if(!base)
+   {
+      double      x;
+      long double lx;
+      float       f;
+
+      errno = 0;
+      x     = str2d(ps, &pex);
+      fuzz_check("str2d", ps, base, !memcmp(&x, &d, sizeof(x)), pex == pe, errno == err);
+
+      errno = 0;
+      lx    = str2ld(ps, &pex);
+      fuzz_check("str2ld", ps, base, (lx == ld) || ((lx != lx) && (ld != ld)), pex == pel, errno == errl);
+
+      errno = 0;
+      f     = str2f(ps, &pex);
+      fuzz_check("str2f", ps, base, (f == (float) d) || ((f != f) && (d != d)), pex == pe, errno == err);
+   }
+
+   /* The C library knows decimal and hexadecimal numbers only and accepts some more formats
+      like ".5", "0x.8" or "nan(...)". strtod detects hexadecimal numbers even if the base is 10.
+      Otherwise strtod must not stop before the end of str2d_r and has to return the same value
+      if both stop at the same position. */
+   if(!err && ((base == 10) || (base == 0)) && !strchr(ps, '~') && !strpbrk(ps, base ? "xX" : "bBoO"))
+   {
+      double x = strtod(ps, &pex);
+
+      fuzz_check("strtod", ps, base, (pex != pe) || (ulp_distance(d, x) <= FUZZ_MAX_ULP), pex >= pe, 1);
+   }
+} /* void fuzz_floats(const char * ps, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   checks of str2num_any against the conversion of the returned type
+\* ------------------------------------------------------------------------- */
+
+static void fuzz_any(const char * ps, int base)
+{
+   s2n_any      a    = str2num_any(ps, base);
+   const char * pb   = ps;
+   char *       pe   = NULL;
+   char *       pei  = NULL;
+   char *       peu  = NULL;
+   int          err  = -1;
+   int          ei   = -1;
+   int          eu   = -1;
+   double       d    = str2d_r(ps, &pe, base, &err);
+   int64_t      i64  = str2i64_r(ps, &pei, base ? base : 1, &ei); /* str2d_r detects bases like base 1 */
+   uint64_t     u64  = str2u64_r(ps, &peu, base ? base : 1, &eu);
+   int          type = S2N_ANY_D;
+   int          neg;
+
+   while(IS_BLANK(*pb))
+      ++pb;
+   neg = (*pb == '-');
+
+   /* an integer that ends where the double ends is an int64_t or a uint64_t in range */
+   if(err == EINVAL)
+      type = S2N_ANY_ERR;
+   else if((pei == pe) && (d - d == 0.0)) /* not inf or nan */
+   {
+      if(!ei)
+         type = S2N_ANY_I64;
+      else if(!eu && !neg)
+         type = S2N_ANY_U64;
+   }
+
+   fuzz_check("str2num_any", ps, base, a.type == type, 1, 1);
+
+   switch(a.type)
+   {
+      case S2N_ANY_I64:
+         fuzz_check("str2num_any", ps, base, a.value.i64 == i64, ps + a.len == pei, !a.err && !ei);
+         break;
+      case S2N_ANY_U64:
+         fuzz_check("str2num_any", ps, base, a.value.u64 == u64, ps + a.len == peu, !a.err && (ei == ERANGE) && !eu);
+         break;
+      case S2N_ANY_D:
+         fuzz_check("str2num_any", ps, base, !memcmp(&a.value.d, &d, sizeof(d)), ps + a.len == pe, !a.err && !err);
+         break;
+      default:
+         fuzz_check("str2num_any", ps, base, a.type == S2N_ANY_ERR, !a.len, (a.err == EINVAL) && (err == EINVAL));
+         break;
+   }
+} /* void fuzz_any(const char * ps, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   LLVMFuzzerTestOneInput is the entry point of libFuzzer. The first byte of
+   the data selects the numeric base 0 to 37 (37 is an invalid base) and the
+   remaining bytes are the string. The string is copied into a buffer of its
+   exact size so that the address sanitizer notices any reads beyond it.
+\* ------------------------------------------------------------------------- */
+
+int LLVMFuzzerTestOneInput(const uint8_t * pdata, size_t size)
+{
+   char * ps;
+   int    base;
+
+   if(!size)
+      return (0);
+
+   base = (int) (pdata[0] % 38);
+   ps   = (char *) malloc(size);
+   if(!ps)
+      return (0);
+
+   memcpy(ps, pdata + 1, size - 1);
+   ps[size - 1] = '\0';
+
+   fuzz_integers(ps, base);
+   fuzz_floats(ps, base);
+   fuzz_any(ps, base);
+
+   free(ps);
+   return (0);
+} /* int LLVMFuzzerTestOneInput(const uint8_t * pdata, size_t size) */
+
+
+#ifdef FUZZ_MAIN
+/* ------------------------------------------------------------------------- *\
+   main runs all files of the command line or stdin through the fuzzer entry
+   point for AFL and for replaying the corpus without libFuzzer
+\* ------------------------------------------------------------------------- */
+
+static int run_file(FILE * pf)
+{
+   static uint8_t buf[0x10000];
+   size_t         size = fread(buf, 1, sizeof(buf), pf);
+
+   return (LLVMFuzzerTestOneInput(buf, size));
+} /* int run_file(FILE * pf) */
+
+int main(int argc, char * argv[])
+{
+   int i;
+
+   if(argc < 2)
+      return (run_file(stdin));
+
+   for(i = 1; i < argc; ++i)
+   {
+      FILE * pf = fopen(argv[i], "rb");
+
+      if(!pf)
+      {
+         fprintf(stderr, "Can't read %s!\n", argv[i]);
+         return (1);
+      }
+
+      run_file(pf);
+      fclose(pf);
+   }
+
+   printf("%d inputs passed\n", argc - 1);
+   return (0);
+} /* main() */
+#endif /* FUZZ_MAIN */
+
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -46,40 +46,166 @@
 #include <str2num.h>
 
 /* table for fast decoding ascii encoded numbers e.g. if (Digit[c] < 10) i = Digit[c]; */
-const uint8_t digit_value[256] = { 64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
-                               /*      !  "  #  $   %  &  '   (  )  *  +   ,  -  .  /     0  1  2  3   4  5  6  7   8  9  :  ;   <  =  >  ?  */
-                                   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,    0, 1, 2, 3,  4, 5, 6, 7,  8, 9,64,64, 64,64,64,64,
-                               /*   @  A  B  C   D  E  F  G   H  I  J  K   L  M  N  O     P  Q  R  S   T  U  V  W   X  Y  Z  [   \  ]  ^  _  */
-                                   64,10,11,12, 13,14,15,16, 17,18,19,20, 21,22,23,24,   25,26,27,28, 29,30,31,32, 33,34,35,64, 64,64,64,64,
-                               /*   `  a  b  c   d  e  f  g   h  i  j  k   l  m  n  o     p  q  r  s   t  u  v  w   x  y  z  {   |  }  ~     */
-                                   64,10,11,12, 13,14,15,16, 17,18,19,20, 21,22,23,24,   25,26,27,28, 29,30,31,32, 33,34,35,64, 64,64,64,64,
+S2N_DATA const uint8_t digit_value[256] = { 64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
+                                        /*      !  "  #  $   %  &  '   (  )  *  +   ,  -  .  /     0  1  2  3   4  5  6  7   8  9  :  ;   <  =  >  ?  */
+                                            64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,    0, 1, 2, 3,  4, 5, 6, 7,  8, 9,64,64, 64,64,64,64,
+                                        /*   @  A  B  C   D  E  F  G   H  I  J  K   L  M  N  O     P  Q  R  S   T  U  V  W   X  Y  Z  [   \  ]  ^  _  */
+                                            64,10,11,12, 13,14,15,16, 17,18,19,20, 21,22,23,24,   25,26,27,28, 29,30,31,32, 33,34,35,64, 64,64,64,64,
+                                        /*   `  a  b  c   d  e  f  g   h  i  j  k   l  m  n  o     p  q  r  s   t  u  v  w   x  y  z  {   |  }  ~     */
+                                            64,10,11,12, 13,14,15,16, 17,18,19,20, 21,22,23,24,   25,26,27,28, 29,30,31,32, 33,34,35,64, 64,64,64,64,
+
+                                            64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
+                                            64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
+                                            64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
+                                            64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64 };
+
+#if S2N_USE_DIGIT_TABLE
+#define DIGIT_VALUE(c) digit_value[(uint8_t) (c)]
+#else
+/* ------------------------------------------------------------------------- *\
+   s2n_digit_calc computes the value of a digit like digit_value does. The
+   comparisons are usually compiled without any branches.
+\* ------------------------------------------------------------------------- */
+static uint8_t s2n_digit_calc(uint8_t c)
+{
+   uint32_t d = (uint32_t) c - '0';           /* '0' - '9' */
+   uint32_t l = ((uint32_t) c | 0x20) - 'a';  /* 'a' - 'z' and 'A' - 'Z' */
+
+   if(d < 10)
+      return ((uint8_t) d);
+
+   return ((uint8_t) ((l < 26) ? l + 10 : 64));
+} /* uint8_t s2n_digit_calc(uint8_t c) */
+
+#define DIGIT_VALUE(c) s2n_digit_calc((uint8_t) (c))
+#endif
+
+
+#if S2N_STATS
+#if defined(_MSC_VER)
+#define S2N_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define S2N_THREAD_LOCAL __thread
+#else
+#define S2N_THREAD_LOCAL _Thread_local
+#endif
+
+/* counters of the current thread */
+static S2N_THREAD_LOCAL s2n_stats s2n_thread_stats;
+
+#define STAT_INC(n)        (++s2n_thread_stats.n)
+#define STAT_CALL(f, base) (++s2n_thread_stats.calls[f][((unsigned) (base) <= 36) ? (base) : 37])
+#define STAT_ERR(err)      if((err) == EINVAL) ++s2n_thread_stats.invalid; else if((err) == ERANGE) ++s2n_thread_stats.range
+#else
+#define STAT_INC(n)
+#define STAT_CALL(f, base)
+#define STAT_ERR(err)
+#endif
+
+
+/* The functions that return structures inline the conversion so that the end position and
+   the error don't need to be stored in memory. */
+#if defined(__GNUC__)
+#define S2N_FLATTEN __attribute__((flatten))
+#else
+#define S2N_FLATTEN
+#endif
+
+/* Helpers that are shared by several conversions are inlined into each of them. */
+#if defined(__GNUC__)
+#define S2N_INLINE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define S2N_INLINE static __forceinline
+#else
+#define S2N_INLINE static
+#endif
+
+
+#if S2N_USDT
+#include <sys/sdt.h>
+
+/* static tracepoints str2num:error (function, string, end, error), str2num:truncate
+   (function, string, position of the dropped digit) and str2num:split (function, string,
+   exponent) where function is the S2N_STAT_* index of the function */
+#define PROBE3(name, a, b, c)    DTRACE_PROBE3(str2num, name, a, b, c)
+#define PROBE4(name, a, b, c, d) DTRACE_PROBE4(str2num, name, a, b, c, d)
+#else
+#define PROBE3(name, a, b, c)    ((void) 0)
+#define PROBE4(name, a, b, c, d) ((void) 0)
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   str2num_stats copies the counters of the current thread.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int str2num_stats(s2n_stats * pstats)
+{
+   if(!pstats)
+      return (EINVAL);
+
+#if S2N_STATS
+   *pstats = s2n_thread_stats;
+   return (0);
+#else
+   memset(pstats, 0, sizeof(*pstats));
+   return (ENOSYS);
+#endif
+} /* int str2num_stats(s2n_stats * pstats) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2num_stats_reset clears the counters of the current thread.
+\* ------------------------------------------------------------------------- */
+
+S2N_API void str2num_stats_reset(void)
+{
+#if S2N_STATS
+   memset(&s2n_thread_stats, 0, sizeof(s2n_thread_stats));
+#endif
+} /* void str2num_stats_reset(void) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2num_stats_add adds the counters of *pstats to *psum. All members of
+   s2n_stats are counters of the type uint64_t.
+\* ------------------------------------------------------------------------- */
+
+S2N_API void str2num_stats_add(s2n_stats * psum, const s2n_stats * pstats)
+{
+   uint64_t *       pd = (uint64_t *) psum;
+   const uint64_t * ps = (const uint64_t *) pstats;
+   size_t           i;
+
+   if(!psum || !pstats)
+      return;
+
+   for(i = 0; i < sizeof(s2n_stats) / sizeof(uint64_t); ++i)
+      pd[i] += ps[i];
+} /* void str2num_stats_add(s2n_stats * psum, const s2n_stats * pstats) */
 
-                                   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
-                                   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
-                                   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,
-                                   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64,   64,64,64,64, 64,64,64,64, 64,64,64,64, 64,64,64,64 };
 
 
 /* ========================================================================= *\
    Floating point conversion functions
 \* ========================================================================= */
 
-static uint32_t inf   = 0x7f800000;
-static uint32_t ninf  = 0xff800000;
-static uint32_t nan   = 0x7fc00000;
-static uint32_t nnan  = 0xffc00000;
-static void *   pvinf  = &inf;
-static void *   pvninf = &ninf;
-static void *   pvnan  = &nan;
-static void *   pvnnan = &nnan;
+static uint32_t s2n_inf   = 0x7f800000;
+static uint32_t s2n_ninf  = 0xff800000;
+static uint32_t s2n_nan   = 0x7fc00000;
+static uint32_t s2n_nnan  = 0xffc00000;
+static void *   s2n_pvinf  = &s2n_inf;
+static void *   s2n_pvninf = &s2n_ninf;
+static void *   s2n_pvnan  = &s2n_nan;
+static void *   s2n_pvnnan = &s2n_nnan;
 
 
 /* ------------------------------------------------------------------------- *\
-   powil calculates a power of the base and returns it as a long double.
+   s2n_powil calculates a power of the base and returns it as a long double.
    See comments of rebase() in callback_printf for details.
 \* ------------------------------------------------------------------------- */
 
-static long double powil (uint8_t base, uint32_t expo)
+static long double s2n_powil (uint8_t base, uint32_t expo)
 {
    long double val = 1.0;
 
@@ -122,15 +248,15 @@ static long double powil (uint8_t base, uint32_t expo)
    }
 
    return (val);
-} /* long double powil (uint8_t base, uint32_t expo) */
+} /* long double s2n_powil (uint8_t base, uint32_t expo) */
 
 
 /* ------------------------------------------------------------------------- *\
-   powi calculates a power of the base and returns it as a double.
+   s2n_powi calculates a power of the base and returns it as a double.
    See comments of rebase() in callback_printf.c for details.
 \* ------------------------------------------------------------------------- */
 
-static double powi (uint8_t base, uint32_t expo)
+static double s2n_powi (uint8_t base, uint32_t expo)
 {
    double val = 1.0;
 
@@ -173,14 +299,14 @@ static double powi (uint8_t base, uint32_t expo)
    }
 
    return (val);
-} /* double powi (uint8_t base, int32_t expo) */
+} /* double s2n_powi (uint8_t base, int32_t expo) */
 
 
 /* ------------------------------------------------------------------------- *\
    str2ld_r reads a long double from a string and cares about a specified base.
 \* ------------------------------------------------------------------------- */
 
-long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
+S2N_API long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
 {
 #if S2N_USE_POW10_ARRAY
    static const long double pow10a[] = { 1e-99L, 1e-98L, 1e-97L, 1e-96L, 1e-95L, 1e-94L, 1e-93L, 1e-92L, 1e-91L, 1e-90L,
@@ -217,6 +343,8 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
    int32_t      c     = 0;   /* correction of comma position */
    uint8_t      d     = 0;   /* last found digit */
 
+   STAT_CALL(S2N_STAT_LD, base);
+
    if(!ps || (base < 0) || (base > 36))
       goto Exit;
 
@@ -238,27 +366,29 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
    if(((*ps | 0x20) == 'i') && ((*(ps+1)  | 0x20) == 'n') && ((*(ps+2) | 0x20) == 'f'))
    { /* "INF" found */
       if (((*(ps+3) | 0x20) == 'i') && ((*(ps+4)  | 0x20) == 'n') && ((*(ps+5) | 0x20) == 'i') && ((*(ps+6) | 0x20) == 't') && ((*(ps+7) | 0x20) == 'y') &&
-          ((base <= 34) || (((digit_value[(uint8_t) *(ps+8)] >= base) && (*(ps+8) != '.') && (*(ps+8) != '~')))))
+          ((base <= 34) || (((DIGIT_VALUE(*(ps+8)) >= base) && (*(ps+8) != '.') && (*(ps+8) != '~')))))
       {
          ps += 8;
 
          if(sign >= 0)
-            dret = *(float*) pvinf;
+            dret = *(float*) s2n_pvinf;
          else
-            dret = *(float*) pvninf;
+            dret = *(float*) s2n_pvninf;
+         STAT_INC(inf);
 
          err = 0;
          goto Exit;
       }
 
-      if ((base <= 23) || ((digit_value[(uint8_t) *(ps+3)] >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
+      if ((base <= 23) || ((DIGIT_VALUE(*(ps+3)) >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
       {
          ps += 3;
 
          if(sign >= 0)
-            dret = *(float*) pvinf;
+            dret = *(float*) s2n_pvinf;
          else
-            dret = *(float*) pvninf;
+            dret = *(float*) s2n_pvninf;
+         STAT_INC(inf);
 
          err = 0;
          goto Exit;
@@ -266,14 +396,15 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
    }
    else if(((*ps | 0x20) == 'n') && ((*(ps+1)  | 0x20) == 'a') && ((*(ps+2) | 0x20) == 'n'))
    { /* "NAN" found */
-      if ((base <= 23) || ((digit_value[(uint8_t) *(ps+3)] >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
+      if ((base <= 23) || ((DIGIT_VALUE(*(ps+3)) >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
       {
          ps += 3;
 
          if(sign >= 0)
-            dret = *(float*) pvnan;
+            dret = *(float*) s2n_pvnan;
          else
-            dret = *(float*) pvnnan;
+            dret = *(float*) s2n_pvnnan;
+         STAT_INC(nan);
 
          err = 0;
          goto Exit;
@@ -286,20 +417,23 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
 
       if(*ps == '0')
       {
-         if(((*(ps+1) == 'x') || (*(ps+1) == 'X')) && (digit_value[(uint8_t) *(ps+2)] < 16))
+         if(((*(ps+1) == 'x') || (*(ps+1) == 'X')) && (DIGIT_VALUE(*(ps+2)) < 16))
          {
             base = 16;
             ps += 2;
+            STAT_INC(prefix);
          }
-         else if(((*(ps+1) == 'b') || (*(ps+1) == 'B')) && (digit_value[(uint8_t) *(ps+2)] < 2))
+         else if(((*(ps+1) == 'b') || (*(ps+1) == 'B')) && (DIGIT_VALUE(*(ps+2)) < 2))
          {
             base = 2;
             ps += 2;
+            STAT_INC(prefix);
          }
-         else if(((*(ps+1) == 'o') || (*(ps+1) == 'O')) && (digit_value[(uint8_t) *(ps+2)] < 8))
+         else if(((*(ps+1) == 'o') || (*(ps+1) == 'O')) && (DIGIT_VALUE(*(ps+2)) < 8))
          {
             base = 8;
             ps += 2;
+            STAT_INC(prefix);
          }
       }
    }/* if(base < 2) */
@@ -307,15 +441,24 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
    {
       /* Care about base specifications in hex data even if base is given.
          (It's a rather dirty thing within the specification of strtoul.) */
-      if ((base == 16) && ((ps[1] == 'x') || (ps[1] == 'X')) && (digit_value[(uint8_t) ps[2]] < 16))
+      if ((base == 16) && ((ps[1] == 'x') || (ps[1] == 'X')) && (DIGIT_VALUE(ps[2]) < 16))
+      {
          ps += 2;
-      else if ((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (digit_value[(uint8_t) ps[2]] < 2))
+         STAT_INC(prefix);
+      }
+      else if ((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (DIGIT_VALUE(ps[2]) < 2))
+      {
          ps += 2;
-      else if ((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (digit_value[(uint8_t) ps[2]] < 8))
+         STAT_INC(prefix);
+      }
+      else if ((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (DIGIT_VALUE(ps[2]) < 8))
+      {
          ps += 2;
+         STAT_INC(prefix);
+      }
    }
 
-   if(digit_value[(uint8_t) *ps] >= base)
+   if(DIGIT_VALUE(*ps) >= base)
    { /* not a valid number */
       ps = psrc;
       goto Exit;
@@ -324,17 +467,17 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
    while (*ps == '0')
       ++ps; /* skip leading zeros */
 
-   d = digit_value[(uint8_t) *ps];
+   d = DIGIT_VALUE(*ps);
    if(d < base)
    {
       m0 = d;
-      d  = digit_value[(uint8_t) *(++ps)];
+      d  = DIGIT_VALUE(*(++ps));
 
       while((d < base) && (m0 < 0x20000000000000ll))
       { /* m0 won't yet overflow */
          m0 *= base;
          m0 += d;
-         d = digit_value[(uint8_t) *(++ps)];
+         d = DIGIT_VALUE(*(++ps));
       }
 
       while(d < base)
@@ -350,21 +493,23 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
          else
          {
             ++c;
+            STAT_INC(truncated);
+            PROBE3(truncate, S2N_STAT_LD, psrc, ps);
          }
 
-         d = digit_value[(uint8_t) *(++ps)];
+         d = DIGIT_VALUE(*(++ps));
       }
    }
 
    if(*ps == '.')
    {
-      d = digit_value[(uint8_t) *(++ps)];
+      d = DIGIT_VALUE(*(++ps));
 
-      while((d < base) && (m0 < 0x20000000000000ll))
-      { /* m0 won't yet overflow */
+      while((d < base) && !m1 && (m0 < 0x20000000000000ll))
+      { /* m0 won't yet overflow and m1 isn't used yet */
          m0 *= base;
          m0 += d;
-         d = digit_value[(uint8_t) *(++ps)];
+         d = DIGIT_VALUE(*(++ps));
          --c;
       }
 
@@ -379,7 +524,12 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
             m0 &= 0x3ffffffffffffffll;
             --c;
          }
-         d = digit_value[(uint8_t) *(++ps)];
+         else
+         {
+            STAT_INC(truncated);
+            PROBE3(truncate, S2N_STAT_LD, psrc, ps);
+         }
+         d = DIGIT_VALUE(*(++ps));
       }
    }
 
@@ -388,14 +538,14 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
       int32_t   exp_sign = 0;   /* whether the exponent is signed */
 
       d = (uint8_t) *(ps+1);
-      if(digit_value[d] < base)
+      if(DIGIT_VALUE(d) < base)
       {
-         e   = digit_value[d];
+         e   = DIGIT_VALUE(d);
          ps += 2;
       }
       else if (d == '+')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < base)
          {
             e   = d;
@@ -404,7 +554,7 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
       }
       else if (d == '-')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < base)
          {
             exp_sign = 1;
@@ -413,12 +563,15 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
          }
       }
 
-      d = digit_value[(uint8_t) *ps];
+      d = DIGIT_VALUE(*ps);
       while(d < base)
       {
-         e *= base;
-         e += d;
-         d  = digit_value[(uint8_t) *(++ps)];
+         if(e < 0x1000000)
+         { /* larger exponents overflow or underflow anyway */
+            e *= base;
+            e += d;
+         }
+         d  = DIGIT_VALUE(*(++ps));
       }
 
       if(exp_sign)
@@ -429,14 +582,14 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
       int32_t   exp_sign = 0;   /* whether the exponent is signed */
 
       d = (uint8_t) *(ps+1);
-      if(digit_value[d] < 10)
+      if(DIGIT_VALUE(d) < 10)
       {
-         e = digit_value[d];
+         e = DIGIT_VALUE(d);
          ps += 2;
       }
       else if (d == '+')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < 10)
          {
             e   = d;
@@ -445,7 +598,7 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
       }
       else if (d == '-')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < 10)
          {
             exp_sign = 1;
@@ -454,12 +607,15 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
          }
       }
 
-      d = digit_value[(uint8_t) *ps];
+      d = DIGIT_VALUE(*ps);
       while(d < 10)
       {
-         e *= 10;
-         e += d;
-         d  = digit_value[(uint8_t) *(++ps)];
+         if(e < 0x1000000)
+         { /* larger exponents overflow or underflow anyway */
+            e *= 10;
+            e += d;
+         }
+         d  = DIGIT_VALUE(*(++ps));
       }
 
       if(exp_sign)
@@ -471,27 +627,33 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
 
    e += c;
 
+   if(!m1 && !m0)
+      dret = 0.0L; /* prevent 0 * inf in case of huge exponents */
+   else
 #if S2N_USE_POW10_ARRAY
    if ((base == 10) && (e < 100) && (e > -100))
    {
       dret = ((long double) m1 * 0x400000000000000ll + m0) * pow10[e];
+      STAT_INC(pow10);
    }
    else
 #endif
    if(e >= 0)
    {
-      dret = ((long double) m1 * 0x400000000000000ll + m0) * powil(base, e);
+      dret = ((long double) m1 * 0x400000000000000ll + m0) * s2n_powil(base, e);
+      STAT_INC(powi);
    }
    else if(e >= -192)
    {
-      dret = ((long double) m1 * 0x400000000000000ll + m0) / powil(base, -e);
+      dret = ((long double) m1 * 0x400000000000000ll + m0) / s2n_powil(base, -e);
+      STAT_INC(powi);
    }
    else
    {  /* Try to prevent a possible overflow within powil */
       long double p;
       c  = e / 2;
       e -= c;
-      p  = powil(base, -c);
+      p  = s2n_powil(base, -c);
 
       dret = ((long double) m1 * 0x400000000000000ll + m0) / p;
 
@@ -499,6 +661,9 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
          p *= base;
 
       dret /= p;
+      STAT_INC(powi);
+      STAT_INC(split);
+      PROBE3(split, S2N_STAT_LD, psrc, e + c);
    }
 
    if(sign < 0)
@@ -508,6 +673,11 @@ long double str2ld_r(const char * psrc, char ** pend, int base, int * perr)
 
 Exit:;
 
+   STAT_ERR(err);
+
+   if(err)
+      PROBE4(error, S2N_STAT_LD, psrc, ps, err);
+
    if(pend)
       *pend = (char *) ps; /* store pointer to end position */
 
@@ -522,7 +692,7 @@ Exit:;
    str2ld is a wrapper for strtold for reading long doubles.
 \* ------------------------------------------------------------------------- */
 
-long double str2ld(const char * psrc, char ** pend)
+S2N_API long double str2ld(const char * psrc, char ** pend)
 {
    int err = 0;
    long double dret = str2ld_r(psrc, pend, 0, &err);
@@ -533,128 +703,92 @@ long double str2ld(const char * psrc, char ** pend)
 
 
 /* ------------------------------------------------------------------------- *\
-   str2d_r reads a double from a string and cares about a specified base.
+   s2n_d_special reads "inf", "infinity" and "nan" behind the sign, stores
+   the value in *pd and the end in *pps and returns 1, otherwise it returns 0.
 \* ------------------------------------------------------------------------- */
 
-double str2d_r(const char * psrc, char ** pend, int base, int * perr)
+S2N_INLINE int s2n_d_special(const char ** pps, int32_t sign, int base, double * pd)
 {
-#if S2N_USE_POW10_ARRAY
-   static const double pow10a[] = { 1e-99, 1e-98, 1e-97, 1e-96, 1e-95, 1e-94, 1e-93, 1e-92, 1e-91, 1e-90,
-                                    1e-89, 1e-88, 1e-87, 1e-86, 1e-85, 1e-84, 1e-83, 1e-82, 1e-81, 1e-80,
-                                    1e-79, 1e-78, 1e-77, 1e-76, 1e-75, 1e-74, 1e-73, 1e-72, 1e-71, 1e-70,
-                                    1e-69, 1e-68, 1e-67, 1e-66, 1e-65, 1e-64, 1e-63, 1e-62, 1e-61, 1e-60,
-                                    1e-59, 1e-58, 1e-57, 1e-56, 1e-55, 1e-54, 1e-53, 1e-52, 1e-51, 1e-50,
-                                    1e-49, 1e-48, 1e-47, 1e-46, 1e-45, 1e-44, 1e-43, 1e-42, 1e-41, 1e-40,
-                                    1e-39, 1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31, 1e-30,
-                                    1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21, 1e-20,
-                                    1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10,
-                                    1e-09, 1e-08, 1e-07, 1e-06, 1e-05, 1e-04, 1e-03, 1e-02, 1e-01,
-                                     1e00,  1e01,  1e02,  1e03,  1e04,  1e05,  1e06,  1e07,  1e08,  1e09,
-                                     1e10,  1e11,  1e12,  1e13,  1e14,  1e15,  1e16,  1e17,  1e18,  1e19,
-                                     1e20,  1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,  1e28,  1e29,
-                                     1e30,  1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,  1e39,
-                                     1e40,  1e41,  1e42,  1e43,  1e44,  1e45,  1e46,  1e47,  1e48,  1e49,
-                                     1e50,  1e51,  1e52,  1e53,  1e54,  1e55,  1e56,  1e57,  1e58,  1e59,
-                                     1e60,  1e61,  1e62,  1e63,  1e64,  1e65,  1e66,  1e67,  1e68,  1e69,
-                                     1e70,  1e71,  1e72,  1e73,  1e74,  1e75,  1e76,  1e77,  1e78,  1e79,
-                                     1e80,  1e81,  1e82,  1e83,  1e84,  1e85,  1e86,  1e87,  1e88,  1e89,
-                                     1e90,  1e91,  1e92,  1e93,  1e94,  1e95,  1e96,  1e97,  1e98,  1e99 };
-
-   static const double * pow10 = pow10a + 99;
-#endif
-
-   double       dret  = 0.0;
-   int          err   = EINVAL;
-   const char * ps    = psrc;
-   uint64_t     m     = 0;   /* mantissa */
-   int32_t      sign  = 0;   /* sign of value */
-   int32_t      e     = 0;   /* value of exponent */
-   int32_t      c     = 0;   /* correction of comma position */
-   uint8_t      d     = 0;   /* last found digit */
-
-   if(!ps || (base < 0) || (base > 36))
-      goto Exit;
-
-   /* skip leading blanks */
-   while((*ps == ' ') || ((*ps >= 0x9) && (*ps <= 0xd)))
-      ++ps;
-
-   if(*ps == '-')
-   {
-      sign = -1;
-      ++ps;
-   }
-   else if(*ps == '+')
-   {
-      sign = 1;
-      ++ps;
-   }
+   const char * ps = *pps;
 
    if(((*ps | 0x20) == 'i') && ((*(ps+1)  | 0x20) == 'n') && ((*(ps+2) | 0x20) == 'f'))
    { /* "INF" found */
       if (((*(ps+3) | 0x20) == 'i') && ((*(ps+4)  | 0x20) == 'n') && ((*(ps+5) | 0x20) == 'i') && ((*(ps+6) | 0x20) == 't') && ((*(ps+7) | 0x20) == 'y') &&
-          ((base <= 34) || (((digit_value[(uint8_t) *(ps+8)] >= base) && (*(ps+8) != '.') && (*(ps+8) != '~')))))
+          ((base <= 34) || (((DIGIT_VALUE(*(ps+8)) >= base) && (*(ps+8) != '.') && (*(ps+8) != '~')))))
       {
-         ps += 8;
+         *pps = ps + 8;
 
          if(sign >= 0)
-            dret = *(float*) pvinf;
+            *pd = *(float*) s2n_pvinf;
          else
-            dret = *(float*) pvninf;
-
-         err = 0;
-         goto Exit;
+            *pd = *(float*) s2n_pvninf;
+         STAT_INC(inf);
+         return (1);
       }
 
-      if ((base <= 23) || ((digit_value[(uint8_t) *(ps+3)] >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
+      if ((base <= 23) || ((DIGIT_VALUE(*(ps+3)) >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
       {
-         ps += 3;
+         *pps = ps + 3;
 
          if(sign >= 0)
-            dret = *(float*) pvinf;
+            *pd = *(float*) s2n_pvinf;
          else
-            dret = *(float*) pvninf;
-
-         err = 0;
-         goto Exit;
+            *pd = *(float*) s2n_pvninf;
+         STAT_INC(inf);
+         return (1);
       }
    }
    else if(((*ps | 0x20) == 'n') && ((*(ps+1)  | 0x20) == 'a') && ((*(ps+2) | 0x20) == 'n'))
    { /* "NAN" found */
-      if ((base <= 23) || ((digit_value[(uint8_t) *(ps+3)] >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
+      if ((base <= 23) || ((DIGIT_VALUE(*(ps+3)) >= base) && (*(ps+3) != '.') && (*(ps+3) != '~')))
       {
-         ps += 3;
+         *pps = ps + 3;
 
          if(sign >= 0)
-            dret = *(float*) pvnan;
+            *pd = *(float*) s2n_pvnan;
          else
-            dret = *(float*) pvnnan;
-
-         err = 0;
-         goto Exit;
+            *pd = *(float*) s2n_pvnnan;
+         STAT_INC(nan);
+         return (1);
       }
    }
 
+   return (0);
+} /* int s2n_d_special(const char ** pps, int32_t sign, int base, double * pd) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_d_prefix detects the base of a double for a base of 0 or 1, skips the
+   prefix of the base at *pps and returns the base.
+\* ------------------------------------------------------------------------- */
+
+S2N_INLINE int s2n_d_prefix(const char ** pps, int base)
+{
+   const char * ps = *pps;
+
    if(base < 2)
    { /* let's detect the base */
       base = 10; /* default base is 10 */
 
       if(*ps == '0')
       {
-         if(((*(ps+1) == 'x') || (*(ps+1) == 'X')) && (digit_value[(uint8_t) *(ps+2)] < 16))
+         if(((*(ps+1) == 'x') || (*(ps+1) == 'X')) && (DIGIT_VALUE(*(ps+2)) < 16))
          {
             base = 16;
             ps += 2;
+            STAT_INC(prefix);
          }
-         else if(((*(ps+1) == 'b') || (*(ps+1) == 'B')) && (digit_value[(uint8_t) *(ps+2)] < 2))
+         else if(((*(ps+1) == 'b') || (*(ps+1) == 'B')) && (DIGIT_VALUE(*(ps+2)) < 2))
          {
             base = 2;
             ps += 2;
+            STAT_INC(prefix);
          }
-         else if(((*(ps+1) == 'o') || (*(ps+1) == 'O')) && (digit_value[(uint8_t) *(ps+2)] < 8))
+         else if(((*(ps+1) == 'o') || (*(ps+1) == 'O')) && (DIGIT_VALUE(*(ps+2)) < 8))
          {
             base = 8;
             ps += 2;
+            STAT_INC(prefix);
          }
       }
    }/* if(base < 2) */
@@ -662,48 +796,69 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
    {
       /* Care about base specifications in hex data even if base is given.
          (It's a rather dirty thing within the specification of strtoul.) */
-      if((base == 16) && ((ps[1] == 'x') || (ps[1] == 'X')) && (digit_value[(uint8_t) ps[2]] < 16))
+      if((base == 16) && ((ps[1] == 'x') || (ps[1] == 'X')) && (DIGIT_VALUE(ps[2]) < 16))
+      {
          ps += 2;
-      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (digit_value[(uint8_t) ps[2]] < 2))
+         STAT_INC(prefix);
+      }
+      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (DIGIT_VALUE(ps[2]) < 2))
+      {
          ps += 2;
-      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (digit_value[(uint8_t) ps[2]] < 8))
+         STAT_INC(prefix);
+      }
+      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (DIGIT_VALUE(ps[2]) < 8))
+      {
          ps += 2;
+         STAT_INC(prefix);
+      }
    }
 
-   if(digit_value[(uint8_t) *ps] >= base)
-   { /* not a valid number */
-      ps = psrc;
-      goto Exit;
-   }
+   *pps = ps;
 
-   while (*ps == '0')
-     ++ps; /* skip leading zeros */
+   return (base);
+} /* int s2n_d_prefix(const char ** pps, int base) */
 
-   d = digit_value[(uint8_t) *ps];
-   if(d < base)
-   {
-      m = d;
-      d = digit_value[(uint8_t) *(++ps)];
 
-      while(d < base)
-      {
-         if (m < 0x400000000000000ll)
-         {
-            m *= base;
-            m += d;
-         }
-         else
-         {
-            ++c;
-         }
+/* ------------------------------------------------------------------------- *\
+   s2n_d_tail reads the fraction and the exponent of a double behind the
+   integer digits of the mantissa m and returns the absolute value. c is the
+   number of integer digits that didn't fit into m. *pps is the position
+   behind the integer digits and receives the end of the number.
+\* ------------------------------------------------------------------------- */
 
-         d = digit_value[(uint8_t) *(++ps)];
-      }
-   }
+#if S2N_USE_POW10_ARRAY
+static const double s2n_pow10[] = { 1e-99, 1e-98, 1e-97, 1e-96, 1e-95, 1e-94, 1e-93, 1e-92, 1e-91, 1e-90,
+                                 1e-89, 1e-88, 1e-87, 1e-86, 1e-85, 1e-84, 1e-83, 1e-82, 1e-81, 1e-80,
+                                 1e-79, 1e-78, 1e-77, 1e-76, 1e-75, 1e-74, 1e-73, 1e-72, 1e-71, 1e-70,
+                                 1e-69, 1e-68, 1e-67, 1e-66, 1e-65, 1e-64, 1e-63, 1e-62, 1e-61, 1e-60,
+                                 1e-59, 1e-58, 1e-57, 1e-56, 1e-55, 1e-54, 1e-53, 1e-52, 1e-51, 1e-50,
+                                 1e-49, 1e-48, 1e-47, 1e-46, 1e-45, 1e-44, 1e-43, 1e-42, 1e-41, 1e-40,
+                                 1e-39, 1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31, 1e-30,
+                                 1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21, 1e-20,
+                                 1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10,
+                                 1e-09, 1e-08, 1e-07, 1e-06, 1e-05, 1e-04, 1e-03, 1e-02, 1e-01,
+                                  1e00,  1e01,  1e02,  1e03,  1e04,  1e05,  1e06,  1e07,  1e08,  1e09,
+                                  1e10,  1e11,  1e12,  1e13,  1e14,  1e15,  1e16,  1e17,  1e18,  1e19,
+                                  1e20,  1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,  1e28,  1e29,
+                                  1e30,  1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,  1e39,
+                                  1e40,  1e41,  1e42,  1e43,  1e44,  1e45,  1e46,  1e47,  1e48,  1e49,
+                                  1e50,  1e51,  1e52,  1e53,  1e54,  1e55,  1e56,  1e57,  1e58,  1e59,
+                                  1e60,  1e61,  1e62,  1e63,  1e64,  1e65,  1e66,  1e67,  1e68,  1e69,
+                                  1e70,  1e71,  1e72,  1e73,  1e74,  1e75,  1e76,  1e77,  1e78,  1e79,
+                                  1e80,  1e81,  1e82,  1e83,  1e84,  1e85,  1e86,  1e87,  1e88,  1e89,
+                                  1e90,  1e91,  1e92,  1e93,  1e94,  1e95,  1e96,  1e97,  1e98,  1e99 };
+#endif
+
+S2N_INLINE double s2n_d_tail(const char * psrc, const char ** pps, uint64_t m, int32_t c, int base)
+{
+   double       dret = 0.0;
+   const char * ps   = *pps;
+   int32_t      e    = 0;   /* value of exponent */
+   uint8_t      d    = 0;   /* last found digit */
 
    if(*ps == '.')
    {
-      d = digit_value[(uint8_t) *(++ps)];
+      d = DIGIT_VALUE(*(++ps));
 
       while(d < base)
       {
@@ -713,7 +868,12 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
             m += d;
             --c;
          }
-         d = digit_value[(uint8_t) *(++ps)];
+         else
+         {
+            STAT_INC(truncated);
+            PROBE3(truncate, S2N_STAT_D, psrc, ps);
+         }
+         d = DIGIT_VALUE(*(++ps));
       }
    }
 
@@ -722,14 +882,14 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
       int32_t exp_sign = 0; /* sign of exponent */
 
       d = (uint8_t) *(ps+1);
-      if(digit_value[d] < base)
+      if(DIGIT_VALUE(d) < base)
       {
-         e   = digit_value[d];
+         e   = DIGIT_VALUE(d);
          ps += 2;
       }
       else if (d == '+')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < base)
          {
             e   = d;
@@ -738,7 +898,7 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
       }
       else if (d == '-')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < base)
          {
             exp_sign = 1;
@@ -747,12 +907,15 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
          }
       }
 
-      d = digit_value[(uint8_t) *ps];
+      d = DIGIT_VALUE(*ps);
       while(d < base)
       {
-         e *= base;
-         e += d;
-         d  = digit_value[(uint8_t) *(++ps)];
+         if(e < 0x1000000)
+         { /* larger exponents overflow or underflow anyway */
+            e *= base;
+            e += d;
+         }
+         d  = DIGIT_VALUE(*(++ps));
       }
 
       if(exp_sign)
@@ -763,14 +926,14 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
       int32_t exp_sign = 0;
 
       d = (uint8_t) *(ps+1);
-      if(digit_value[d] < 10)
+      if(DIGIT_VALUE(d) < 10)
       {
-         e = digit_value[d];
+         e = DIGIT_VALUE(d);
          ps += 2;
       }
       else if (d == '+')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < 10)
          {
             e   = d;
@@ -779,7 +942,7 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
       }
       else if (d == '-')
       {
-         d = digit_value[(uint8_t) *(ps+2)];
+         d = DIGIT_VALUE(*(ps+2));
          if(d < 10)
          {
             exp_sign = 1;
@@ -788,12 +951,15 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
          }
       }
 
-      d = digit_value[(uint8_t) *ps];
+      d = DIGIT_VALUE(*ps);
       while(d < 10)
       {
-         e *= 10;
-         e += d;
-         d = digit_value[(uint8_t) *(++ps)];
+         if(e < 0x1000000)
+         { /* larger exponents overflow or underflow anyway */
+            e *= 10;
+            e += d;
+         }
+         d = DIGIT_VALUE(*(++ps));
       }
 
       if(exp_sign)
@@ -805,23 +971,28 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
 
    e += c;
 
+   if(!m)
+      dret = 0.0; /* prevent 0 * inf in case of huge exponents */
+   else
 #if S2N_USE_POW10_ARRAY
    if ((base == 10) && (e < 100) && (e > -100))
    {
-      dret = (double) m * pow10[e];
+      dret = (double) m * s2n_pow10[e + 99];
+      STAT_INC(pow10);
    }
    else
 #endif
    if(e >= 0)
    {
-      dret = (double) m * powi(base, e);
+      dret = (double) m * s2n_powi(base, e);
+      STAT_INC(powi);
    }
    else
    {  /* Try to prevent a possible overflow within powi */
       double p;
       c  = e / 2;
       e -= c;
-      p  = powi(base, -c);
+      p  = s2n_powi(base, -c);
 
       dret = (double) m / p;
 
@@ -829,8 +1000,96 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
          p *= base;
 
       dret /= p;
+      STAT_INC(powi);
+      STAT_INC(split);
+      PROBE3(split, S2N_STAT_D, psrc, e + c);
+   }
+
+   *pps = ps;
+
+   (void) psrc; /* only used by the probes */
+
+   return (dret);
+} /* double s2n_d_tail(const char * psrc, const char ** pps, uint64_t m, int32_t c, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2d_r reads a double from a string and cares about a specified base.
+\* ------------------------------------------------------------------------- */
+
+S2N_API double str2d_r(const char * psrc, char ** pend, int base, int * perr)
+{
+   double       dret  = 0.0;
+   int          err   = EINVAL;
+   const char * ps    = psrc;
+   uint64_t     m     = 0;   /* mantissa */
+   int32_t      sign  = 0;   /* sign of value */
+   int32_t      c     = 0;   /* correction of comma position */
+   uint8_t      d     = 0;   /* last found digit */
+
+   STAT_CALL(S2N_STAT_D, base);
+
+   if(!ps || (base < 0) || (base > 36))
+      goto Exit;
+
+   /* skip leading blanks */
+   while((*ps == ' ') || ((*ps >= 0x9) && (*ps <= 0xd)))
+      ++ps;
+
+   if(*ps == '-')
+   {
+      sign = -1;
+      ++ps;
+   }
+   else if(*ps == '+')
+   {
+      sign = 1;
+      ++ps;
    }
 
+   if(s2n_d_special(&ps, sign, base, &dret))
+   {
+      err = 0;
+      goto Exit;
+   }
+
+   base = s2n_d_prefix(&ps, base);
+
+   if(DIGIT_VALUE(*ps) >= base)
+   { /* not a valid number */
+      ps = psrc;
+      goto Exit;
+   }
+
+   while (*ps == '0')
+     ++ps; /* skip leading zeros */
+
+   d = DIGIT_VALUE(*ps);
+   if(d < base)
+   {
+      m = d;
+      d = DIGIT_VALUE(*(++ps));
+
+      while(d < base)
+      {
+         if (m < 0x400000000000000ll)
+         {
+            m *= base;
+            m += d;
+         }
+         else
+         {
+            ++c;
+            STAT_INC(truncated);
+            PROBE3(truncate, S2N_STAT_D, psrc, ps);
+         }
+
+         d = DIGIT_VALUE(*(++ps));
+      }
+   }
+
+   dret = s2n_d_tail(psrc, &ps, m, c, base);
+
    if(sign < 0)
       dret = -dret;
 
@@ -838,6 +1097,11 @@ double str2d_r(const char * psrc, char ** pend, int base, int * perr)
 
 Exit:;
 
+   STAT_ERR(err);
+
+   if(err)
+      PROBE4(error, S2N_STAT_D, psrc, ps, err);
+
    if(pend)
       *pend = (char *) ps; /* store pointer to end position */
 
@@ -852,7 +1116,7 @@ Exit:;
    str2d is a wrapper for strtod for reading doubles.
 \* ------------------------------------------------------------------------- */
 
-double str2d(const char * psrc, char ** pend)
+S2N_API double str2d(const char * psrc, char ** pend)
 {
    int err = 0;
    double dret = str2d_r(psrc, pend, 0, &err);
@@ -866,7 +1130,7 @@ double str2d(const char * psrc, char ** pend)
    str2f is a wrapper for strtof for reading floats.
 \* ------------------------------------------------------------------------- */
 
-float str2f(const char * psrc, char ** pend)
+S2N_API float str2f(const char * psrc, char ** pend)
 {
    int err = 0;
    float dret = (float) str2d_r(psrc, pend, 0, &err);
@@ -876,6 +1140,169 @@ float str2f(const char * psrc, char ** pend)
 } /* double str2d(const char * psrc, char ** pend) */
 
 
+/* ------------------------------------------------------------------------- *\
+   str2d_ret reads a double and returns the value, the number of converted
+   characters and the error in a structure
+\* ------------------------------------------------------------------------- */
+
+S2N_API S2N_FLATTEN s2n_ret_d str2d_ret(const char * psrc, int base)
+{
+   s2n_ret_d ret;
+   char *    pe  = NULL;
+   int       err = 0;
+
+   ret.value = str2d_r(psrc, &pe, base, &err);
+   ret.len   = (uint32_t) (pe - psrc);
+   ret.err   = err;
+   return (ret);
+} /* s2n_ret_d str2d_ret(const char * psrc, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2ld_ret reads a long double and returns the value, the number of
+   converted characters and the error in a structure
+\* ------------------------------------------------------------------------- */
+
+S2N_API S2N_FLATTEN s2n_ret_ld str2ld_ret(const char * psrc, int base)
+{
+   s2n_ret_ld ret;
+   char *     pe  = NULL;
+   int        err = 0;
+
+   ret.value = str2ld_r(psrc, &pe, base, &err);
+   ret.len   = (uint32_t) (pe - psrc);
+   ret.err   = err;
+   return (ret);
+} /* s2n_ret_ld str2ld_ret(const char * psrc, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2num_any reads a number once and returns an int64_t for integers that
+   fit into it, a uint64_t for larger positive integers and a double for all
+   other numbers. The double continues with the mantissa of the integer
+   digits instead of reading the number again.
+\* ------------------------------------------------------------------------- */
+
+S2N_API s2n_any str2num_any(const char * psrc, int base)
+{
+   s2n_any      ret;
+   const char * ps   = psrc;
+   uint64_t     m    = 0;   /* mantissa of the double */
+   uint64_t     x    = 0;   /* exact value of the integer digits */
+   int32_t      sign = 0;   /* sign of value */
+   int32_t      c    = 0;   /* number of digits that didn't fit into m */
+   int          dbl  = 0;   /* the number is returned as double */
+   uint8_t      d    = 0;   /* last found digit */
+
+   ret.value.u64 = 0;
+   ret.type      = S2N_ANY_ERR;
+   ret.err       = EINVAL;
+
+   if(!ps || (base < 0) || (base > 36))
+      goto Exit;
+
+   /* skip leading blanks */
+   while((*ps == ' ') || ((*ps >= 0x9) && (*ps <= 0xd)))
+      ++ps;
+
+   if(*ps == '-')
+   {
+      sign = -1;
+      ++ps;
+   }
+   else if(*ps == '+')
+   {
+      sign = 1;
+      ++ps;
+   }
+
+   if(s2n_d_special(&ps, sign, base, &ret.value.d))
+   {
+      ret.type = S2N_ANY_D;
+      ret.err  = 0;
+      goto Exit;
+   }
+
+   base = s2n_d_prefix(&ps, base);
+
+   if(DIGIT_VALUE(*ps) >= base)
+   { /* not a valid number */
+      ps = psrc;
+      goto Exit;
+   }
+
+   while (*ps == '0')
+     ++ps; /* skip leading zeros */
+
+   d = DIGIT_VALUE(*ps);
+   while(d < base)
+   {
+      if (m < 0x400000000000000ll)
+      {
+         m *= base;
+         m += d;
+      }
+      else
+      {  /* m keeps the leading digits for the double, x continues exactly */
+         if(!c)
+            x = m;
+         ++c;
+
+         if(!dbl)
+         {
+            if(x > (UINT64_MAX - d) / base)
+               dbl = 1;
+            else
+               x = x * base + d;
+         }
+      }
+
+      d = DIGIT_VALUE(*(++ps));
+   }
+
+   if(!c)
+      x = m;
+
+   /* a fraction or an exponent makes a double */
+   if((*ps == '.') ||
+      ((((base < 15) && ((*ps | 0x20) == 'e')) || (*ps == '~')) &&
+       ((DIGIT_VALUE(ps[1]) < base) || (((ps[1] == '+') || (ps[1] == '-')) && (DIGIT_VALUE(ps[2]) < base)))) ||
+      ((base == 16) && ((*ps | 0x20) == 'p') &&
+       ((DIGIT_VALUE(ps[1]) < 10) || (((ps[1] == '+') || (ps[1] == '-')) && (DIGIT_VALUE(ps[2]) < 10)))))
+      dbl = 1;
+
+   if(dbl || ((sign < 0) && (x > (uint64_t) INT64_MAX + 1)))
+   {
+      ret.value.d = s2n_d_tail(psrc, &ps, m, c, base);
+      if(sign < 0)
+         ret.value.d = -ret.value.d;
+      ret.type = S2N_ANY_D;
+   }
+   else if(sign < 0)
+   {
+      ret.value.i64 = (x > (uint64_t) INT64_MAX) ? INT64_MIN : -(int64_t) x;
+      ret.type      = S2N_ANY_I64;
+   }
+   else if(x > (uint64_t) INT64_MAX)
+   {
+      ret.value.u64 = x;
+      ret.type      = S2N_ANY_U64;
+   }
+   else
+   {
+      ret.value.i64 = (int64_t) x;
+      ret.type      = S2N_ANY_I64;
+   }
+
+   ret.err = 0;
+
+Exit:;
+
+   ret.len = (uint32_t) (ps - psrc);
+   return (ret);
+} /* s2n_any str2num_any(const char * psrc, int base) */
+
+
 /* ========================================================================= *\
    Integer conversion functions
 \* ========================================================================= */
@@ -885,16 +1312,26 @@ float str2f(const char * psrc, char ** pend)
    UFE   unsigned function name that uses errno for errors
    SFN   signed function name
    UFN   unsigned function name
+   SFR   signed function name that returns a structure
+   UFR   unsigned function name that returns a structure
+   SRT   structure that SFR returns
+   URT   structure that UFR returns
    UT    unsigned type
    ST    signed type
    U_MAX maximum of unsigned type
    S_MAX maximum of signed type
    S_MIN minimum of signed type
+   SID   index of the signed function in s2n_stats
+   UID   index of the unsigned function in s2n_stats
 */
 
 
 #define SFE str2i64
 #define UFE str2u64
+#define SFR str2i64_ret
+#define UFR str2u64_ret
+#define SRT s2n_ret_i64
+#define URT s2n_ret_u64
 #define SFN str2i64_r
 #define UFN str2u64_r
 #define UT  uint64_t
@@ -902,11 +1339,17 @@ float str2f(const char * psrc, char ** pend)
 #define U_MAX UINT64_MAX
 #define S_MAX INT64_MAX
 #define S_MIN INT64_MIN
+#define SID S2N_STAT_I64
+#define UID S2N_STAT_U64
 
 #include "str2num.c"
 
 #define SFE str2i32
 #define UFE str2u32
+#define SFR str2i32_ret
+#define UFR str2u32_ret
+#define SRT s2n_ret_i32
+#define URT s2n_ret_u32
 #define SFN str2i32_r
 #define UFN str2u32_r
 #define UT  uint32_t
@@ -914,11 +1357,17 @@ float str2f(const char * psrc, char ** pend)
 #define U_MAX UINT32_MAX
 #define S_MAX INT32_MAX
 #define S_MIN INT32_MIN
+#define SID S2N_STAT_I32
+#define UID S2N_STAT_U32
 
 #include "str2num.c"
 
 #define SFE str2i16
 #define UFE str2u16
+#define SFR str2i16_ret
+#define UFR str2u16_ret
+#define SRT s2n_ret_i16
+#define URT s2n_ret_u16
 #define SFN str2i16_r
 #define UFN str2u16_r
 #define UT  uint16_t
@@ -926,11 +1375,17 @@ float str2f(const char * psrc, char ** pend)
 #define U_MAX UINT16_MAX
 #define S_MAX INT16_MAX
 #define S_MIN INT16_MIN
+#define SID S2N_STAT_I16
+#define UID S2N_STAT_U16
 
 #include "str2num.c"
 
 #define SFE str2i8
 #define UFE str2u8
+#define SFR str2i8_ret
+#define UFR str2u8_ret
+#define SRT s2n_ret_i8
+#define URT s2n_ret_u8
 #define SFN str2i8_r
 #define UFN str2u8_r
 #define UT  uint8_t
@@ -938,58 +1393,447 @@ float str2f(const char * psrc, char ** pend)
 #define U_MAX UINT8_MAX
 #define S_MAX INT8_MAX
 #define S_MIN INT8_MIN
+#define SID S2N_STAT_I8
+#define UID S2N_STAT_U8
 
 #include "str2num.c"
 
 #define SFE str2pd
 #define UFE str2sz
+#define SFR str2pd_ret
+#define UFR str2sz_ret
+#define SRT s2n_ret_pd
+#define URT s2n_ret_sz
 #define SFN str2pd_r
 #define UFN str2sz_r
 #define UT  size_t
 #define ST  ptrdiff_t
 #define U_MAX (~(size_t)0)
-#define S_MIN ((ptrdiff_t) 1 << (sizeof(ptrdiff_t) * 8 - 1))
-#define S_MAX (~S_MIN)
+#define S_MAX ((ptrdiff_t) (U_MAX >> 1))
+#define S_MIN (-S_MAX - 1)
+#define SID S2N_STAT_PD
+#define UID S2N_STAT_SZ
 
 #include "str2num.c"
 
 #define SFE str2ip
 #define UFE str2up
+#define SFR str2ip_ret
+#define UFR str2up_ret
+#define SRT s2n_ret_ip
+#define URT s2n_ret_up
 #define SFN str2ip_r
 #define UFN str2up_r
 #define UT  uintptr_t
 #define ST  intptr_t
 #define U_MAX (~(uintptr_t)0)
-#define S_MIN ((intptr_t) 1 << (sizeof(intptr_t) * 8 - 1))
-#define S_MAX (~S_MIN)
+#define S_MAX ((intptr_t) (U_MAX >> 1))
+#define S_MIN (-S_MAX - 1)
+#define SID S2N_STAT_IP
+#define UID S2N_STAT_UP
+
+#include "str2num.c"
+
+#define SFE str2i
+#define UFE str2u
+#define SFR str2i_ret
+#define UFR str2u_ret
+#define SRT s2n_ret_i
+#define URT s2n_ret_u
+#define SFN str2i_r
+#define UFN str2u_r
+#define UT  unsigned int
+#define ST  int
+#define U_MAX (~(unsigned int)0)
+#define S_MAX ((int) (U_MAX >> 1))
+#define S_MIN (-S_MAX - 1)
+#define SID S2N_STAT_I
+#define UID S2N_STAT_U
 
 #include "str2num.c"
 
 #define SFE str2l
 #define UFE str2ul
+#define SFR str2l_ret
+#define UFR str2ul_ret
+#define SRT s2n_ret_l
+#define URT s2n_ret_ul
 #define SFN str2l_r
 #define UFN str2ul_r
 #define UT  unsigned long
 #define ST  long
 #define U_MAX (~(unsigned long)0)
-#define S_MIN ((long) 1 << (sizeof(long) * 8 - 1))
-#define S_MAX (~S_MIN)
+#define S_MAX ((long) (U_MAX >> 1))
+#define S_MIN (-S_MAX - 1)
+#define SID S2N_STAT_L
+#define UID S2N_STAT_UL
 
 #include "str2num.c"
 
 #define SFE str2ll
 #define UFE str2ull
+#define SFR str2ll_ret
+#define UFR str2ull_ret
+#define SRT s2n_ret_ll
+#define URT s2n_ret_ull
 #define SFN str2ll_r
 #define UFN str2ull_r
 #define UT  unsigned long long
 #define ST  long long
 #define U_MAX (~(unsigned long long)0)
-#define S_MIN ((long long) 1 << (sizeof(long long) * 8 - 1))
-#define S_MAX (~S_MIN)
+#define S_MAX ((long long) (U_MAX >> 1))
+#define S_MIN (-S_MAX - 1)
+#define SID S2N_STAT_LL
+#define UID S2N_STAT_ULL
 
 #include "str2num.c"
 
 
+/* ========================================================================= *\
+   Lazy number tokens
+\* ========================================================================= */
+
+#define IS_DEC_DIGIT(c) ((unsigned) ((c) - '0') < 10u)
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_scan validates a decimal number without converting it.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int s2n_lazy_scan(s2n_lazy * pl, const char * ps, char ** pe)
+{
+   const char * p     = ps;
+   uint16_t     flags = 0;
+   int          err   = EINVAL;
+
+   if(!pl || !ps)
+   {
+      if(pe)
+         *pe = (char *) ps;
+      return (err);
+   }
+
+   while((*p == ' ') || ((*p >= 0x9) && (*p <= 0xd)))
+      ++p;
+
+   pl->ps = p;
+
+   if(*p == '-')
+   {
+      flags = S2N_LAZY_NEG | S2N_LAZY_SIGN;
+      ++p;
+   }
+   else if(*p == '+')
+   {
+      flags = S2N_LAZY_SIGN;
+      ++p;
+   }
+
+   if(!IS_DEC_DIGIT(*p))
+      goto Exit;
+
+   while(IS_DEC_DIGIT(*p))
+      ++p;
+
+   if(*p == '.')
+   {
+      if(!IS_DEC_DIGIT(p[1]))
+         goto Exit; /* str2d_r would read the point as well */
+
+      flags |= S2N_LAZY_FRAC;
+      p += 2;
+      while(IS_DEC_DIGIT(*p))
+         ++p;
+   }
+
+   if((*p | 0x20) == 'e')
+   {
+      if((p[1] == '+') || (p[1] == '-'))
+         ++p;
+
+      if(!IS_DEC_DIGIT(p[1]))
+         goto Exit;
+
+      flags |= S2N_LAZY_FRAC;
+      p += 2;
+      while(IS_DEC_DIGIT(*p))
+         ++p;
+   }
+
+   if((*p == '~') || ((size_t) (p - pl->ps) > UINT32_MAX))
+      goto Exit; /* a '~' starts an exponent of str2d_r */
+
+   err = 0;
+
+   Exit:;
+
+   if(err)
+      p = ps;
+
+   pl->len   = err ? 0 : (uint32_t) (p - pl->ps);
+   pl->flags = err ? 0 : flags;
+   pl->scale = 0;
+   pl->mag   = 0;
+   pl->d     = 0.0;
+   pl->fix   = 0;
+
+   if(pe)
+      *pe = (char *) p;
+
+   return (err);
+} /* int s2n_lazy_scan(s2n_lazy * pl, const char * ps, char ** pe) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_mag converts and caches the magnitude of an integer token.
+\* ------------------------------------------------------------------------- */
+
+static void s2n_lazy_mag(s2n_lazy * pl)
+{
+   int err = 0;
+
+   pl->mag    = str2u64_r(pl->ps + ((pl->flags & S2N_LAZY_SIGN) ? 1 : 0), NULL, 10, &err);
+   pl->flags |= (uint16_t) (err ? (S2N_LAZY_MAG | S2N_LAZY_MAG_ERR) : S2N_LAZY_MAG);
+} /* void s2n_lazy_mag(s2n_lazy * pl) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_i64 returns the int64_t value of a token.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int s2n_lazy_i64(s2n_lazy * pl, int64_t * pv)
+{
+   int64_t v   = 0;
+   int     err = EINVAL;
+
+   if(!pl || !pl->len || (pl->flags & S2N_LAZY_FRAC))
+      goto Exit;
+
+   if(!(pl->flags & S2N_LAZY_MAG))
+      s2n_lazy_mag(pl);
+
+   err = 0;
+
+   if(pl->flags & S2N_LAZY_NEG)
+   {
+      if((pl->flags & S2N_LAZY_MAG_ERR) || (pl->mag > (uint64_t) INT64_MAX + 1))
+      {
+         v   = INT64_MIN;
+         err = ERANGE;
+      }
+      else
+      {
+         v = (pl->mag > (uint64_t) INT64_MAX) ? INT64_MIN : -(int64_t) pl->mag;
+      }
+   }
+   else if((pl->flags & S2N_LAZY_MAG_ERR) || (pl->mag > (uint64_t) INT64_MAX))
+   {
+      v   = INT64_MAX;
+      err = ERANGE;
+   }
+   else
+   {
+      v = (int64_t) pl->mag;
+   }
+
+   Exit:;
+
+   if(pv)
+      *pv = v;
+
+   return (err);
+} /* int s2n_lazy_i64(s2n_lazy * pl, int64_t * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_u64 returns the uint64_t value of a token.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int s2n_lazy_u64(s2n_lazy * pl, uint64_t * pv)
+{
+   uint64_t v   = 0;
+   int      err = EINVAL;
+
+   if(!pl || !pl->len || (pl->flags & S2N_LAZY_FRAC))
+      goto Exit;
+
+   if(!(pl->flags & S2N_LAZY_MAG))
+      s2n_lazy_mag(pl);
+
+   err = 0;
+
+   if(pl->flags & S2N_LAZY_MAG_ERR)
+   {
+      v   = UINT64_MAX;
+      err = ERANGE;
+   }
+   else
+   {
+      v = (pl->flags & S2N_LAZY_NEG) ? 0 - pl->mag : pl->mag; /* a '-' negates the value like str2u64_r */
+   }
+
+   Exit:;
+
+   if(pv)
+      *pv = v;
+
+   return (err);
+} /* int s2n_lazy_u64(s2n_lazy * pl, uint64_t * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_d returns the double value of a token.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int s2n_lazy_d(s2n_lazy * pl, double * pv)
+{
+   int err = EINVAL;
+
+   if(!pl || !pl->len)
+   {
+      if(pv)
+         *pv = 0.0;
+      return (err);
+   }
+
+   if(!(pl->flags & S2N_LAZY_D))
+   {
+      if(((pl->flags & (S2N_LAZY_MAG | S2N_LAZY_MAG_ERR)) == S2N_LAZY_MAG) && (pl->mag <= ((uint64_t) 1 << 53)))
+         pl->d = (pl->flags & S2N_LAZY_NEG) ? -(double) pl->mag : (double) pl->mag; /* exact integer of a previous access */
+      else
+         pl->d = str2d_r(pl->ps, NULL, 10, NULL);
+
+      pl->flags |= S2N_LAZY_D;
+   }
+
+   if(pv)
+      *pv = pl->d;
+
+   return (0);
+} /* int s2n_lazy_d(s2n_lazy * pl, double * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_lazy_fix returns the fixed point value of a token with scale decimal
+   places.
+\* ------------------------------------------------------------------------- */
+
+S2N_API int s2n_lazy_fix(s2n_lazy * pl, int scale, int64_t * pv)
+{
+   const char * p     = NULL;
+   const char * pend  = NULL;
+   uint64_t     limit = (uint64_t) INT64_MAX;
+   uint64_t     m     = 0;
+   int64_t      keep  = 0;
+   int32_t      e     = 0;
+   int32_t      nint  = 0;
+   int          err   = EINVAL;
+
+   if(!pl || !pl->len || (scale < 0) || (scale > 18))
+   {
+      if(pv)
+         *pv = 0;
+      return (err);
+   }
+
+   if((pl->flags & S2N_LAZY_FIX) && (pl->scale == scale))
+      goto Exit;
+
+   if(pl->flags & S2N_LAZY_NEG)
+      limit += 1;
+
+   p    = pl->ps + ((pl->flags & S2N_LAZY_SIGN) ? 1 : 0);
+   pend = pl->ps + pl->len;
+
+   while((p + nint < pend) && IS_DEC_DIGIT(p[nint]))
+      ++nint;
+
+   if(pl->flags & S2N_LAZY_FRAC)
+   {  /* read the exponent from the end of the token */
+      const char * pe = pend;
+      int32_t      f  = 1;
+
+      while((pe > p) && IS_DEC_DIGIT(pe[-1]))
+         --pe;
+
+      if((pe > p) && ((pe[-1] == '-') || (pe[-1] == '+') || ((pe[-1] | 0x20) == 'e')))
+      {
+         const char * px = pe;
+
+         if(pe[-1] == '-')
+            f = -1;
+
+         while((px < pend) && (e < 100000))
+            e = e * 10 + (*px++ - '0');
+
+         e   *= f;
+         pend = pe - (((pe[-1] | 0x20) == 'e') ? 1 : 2);
+      }
+   }
+
+   /* number of leading mantissa digits of the integer part of the result */
+   keep = (int64_t) nint + e + scale;
+
+   err = 0;
+
+   while((p < pend) && (keep > 0))
+   {
+      unsigned d = (unsigned) (*p++ - '0');
+
+      if(d > 9)
+         continue; /* decimal point */
+
+      if(m > (limit - d) / 10)
+      {
+         err = ERANGE;
+         break;
+      }
+
+      m = m * 10 + d;
+      --keep;
+   }
+
+   while(!err && m && (keep > 0))
+   {
+      if(m > limit / 10)
+      {
+         err = ERANGE;
+         break;
+      }
+
+      m *= 10;
+      --keep;
+   }
+
+   if(err)
+      m = limit;
+
+   pl->fix    = (pl->flags & S2N_LAZY_NEG) ? ((m > (uint64_t) INT64_MAX) ? INT64_MIN : -(int64_t) m) : (int64_t) m;
+   pl->scale  = (int16_t) scale;
+   pl->flags &= (uint16_t) ~S2N_LAZY_FIX_ERR;
+   pl->flags |= (uint16_t) (err ? (S2N_LAZY_FIX | S2N_LAZY_FIX_ERR) : S2N_LAZY_FIX);
+
+   Exit:;
+
+   if(pv)
+      *pv = pl->fix;
+
+   return ((pl->flags & S2N_LAZY_FIX_ERR) ? ERANGE : 0);
+} /* int s2n_lazy_fix(s2n_lazy * pl, int scale, int64_t * pv) */
+
+#undef IS_DEC_DIGIT
+
+/* The helper macros aren't needed anymore and must not leak into the files
+   that include str2num.c in case of S2N_HEADER_ONLY. */
+#undef DIGIT_VALUE
+#undef STAT_INC
+#undef STAT_CALL
+#undef STAT_ERR
+#undef PROBE3
+#undef PROBE4
+#undef S2N_THREAD_LOCAL
+#undef S2N_FLATTEN
+#undef S2N_INLINE
+
 #else /* STR2NUM_C */
 
 /* ========================================================================= *\
@@ -1000,7 +1844,7 @@ float str2f(const char * psrc, char ** pend)
    UFN converts a string to an unsigned integer type
 \* ------------------------------------------------------------------------- */
 
-UT UFN (const char * ps, char ** pe, int base, int * perr)
+S2N_API UT UFN (const char * ps, char ** pe, int base, int * perr)
 {
    UT  u_ret = 0;
    int err   = 0;
@@ -1012,6 +1856,8 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
    UT d;
    int sign = 0;
 
+   STAT_CALL(UID, base);
+
    if(!ps)
    {
       err = EINVAL;
@@ -1049,31 +1895,34 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
       else if(*ps == '0')
       {
          ++ps;
-         if(((*ps == 'x') || (*ps == 'X')) && (digit_value[(uint8_t) ps[1]] < 16))
+         if(((*ps == 'x') || (*ps == 'X')) && (DIGIT_VALUE(ps[1]) < 16))
          {
             base = 16;
             ++ps;
+            STAT_INC(prefix);
          }
-         else if(((*ps == 'b') || (*ps == 'B')) && (digit_value[(uint8_t) ps[1]] < 2))
+         else if(((*ps == 'b') || (*ps == 'B')) && (DIGIT_VALUE(ps[1]) < 2))
          {
             base = 2;
             ++ps;
+            STAT_INC(prefix);
          }
-         else if(((*ps == 'o') || (*ps == 'O')) && (digit_value[(uint8_t) ps[1]] < 2))
+         else if(((*ps == 'o') || (*ps == 'O')) && (DIGIT_VALUE(ps[1]) < 8))
          {
             base = 8;
             ++ps;
+            STAT_INC(prefix);
          }
          else if(!base)
          { /* if base is 0 than the default base after a leading 0 is 8 */
             base = 8;
-            if (digit_value[(uint8_t) *ps] >= 8)
+            if (DIGIT_VALUE(*ps) >= 8)
                goto Exit;
          }
          else
          { /* if base is 1 than the default base after a leading 0 is 10 */
             base = 10;
-            if (digit_value[(uint8_t) *ps] >= 10)
+            if (DIGIT_VALUE(*ps) >= 10)
                goto Exit;
          }
       }
@@ -1094,17 +1943,26 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
    {
       /* Care about base specifications in hex data even if base is given.
          (It's a rather dirty thing within the specification of strtoul.) */
-      if((base == 16)  && ((ps[1] == 'x') || (ps[1] == 'X')) && (digit_value[(uint8_t) ps[2]] < 16))
+      if((base == 16)  && ((ps[1] == 'x') || (ps[1] == 'X')) && (DIGIT_VALUE(ps[2]) < 16))
+      {
          ps += 2;
-      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (digit_value[(uint8_t) ps[2]] < 2))
+         STAT_INC(prefix);
+      }
+      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (DIGIT_VALUE(ps[2]) < 2))
+      {
          ps += 2;
-      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (digit_value[(uint8_t) ps[2]] < 8))
+         STAT_INC(prefix);
+      }
+      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (DIGIT_VALUE(ps[2]) < 8))
+      {
          ps += 2;
+         STAT_INC(prefix);
+      }
    }
 
    max = max_base[base];
 
-   d = digit_value[(uint8_t) *ps];
+   d = DIGIT_VALUE(*ps);
    if(d >= (uint8_t) base)
    {
       ps  = psrc;
@@ -1113,13 +1971,13 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
    }
 
    u_ret = d;
-   d = digit_value[(uint8_t) *(++ps)];
+   d = DIGIT_VALUE(*(++ps));
 
    while(d < (uint8_t) base)
    {
       if(u_ret >= max)
       {
-         if(((uint8_t) base > digit_value[(uint8_t) *(ps+1)]) || (u_ret > max) || ((u_ret * base) > (U_MAX - d)))
+         if(((uint8_t) base > DIGIT_VALUE(*(ps+1))) || (u_ret > max) || ((u_ret * base) > (U_MAX - d)))
          {
             err   = ERANGE; /* indicate overflow error */
 #if S2N_UMIN_IS_SMIN
@@ -1136,7 +1994,7 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
             }
 #if 1
             /* Move to end of valid digits even if those exceed the range of our type. */
-            while ((uint8_t) base > digit_value[(uint8_t) *(++ps)])
+            while ((uint8_t) base > DIGIT_VALUE(*(++ps)))
             {}
 #endif
             goto Exit;
@@ -1144,7 +2002,7 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
       }
 
       u_ret = u_ret * base + d;
-      d = digit_value[(uint8_t) *(++ps)];
+      d = DIGIT_VALUE(*(++ps));
    }
 
    if (sign < 0)
@@ -1166,6 +2024,11 @@ UT UFN (const char * ps, char ** pe, int base, int * perr)
 
 Exit:;
 
+   STAT_ERR(err);
+
+   if(err)
+      PROBE4(error, UID, psrc, ps, err);
+
    if(perr)
       *perr = err;
 
@@ -1181,7 +2044,7 @@ Exit:;
    UFE converts a string to an unsigned integer type
 \* ------------------------------------------------------------------------- */
 
-UT UFE (const char * ps, char ** pe, int base)
+S2N_API UT UFE (const char * ps, char ** pe, int base)
 {
    int err;
    UT  u_ret = UFN (ps, pe, base, &err);
@@ -1191,12 +2054,30 @@ UT UFE (const char * ps, char ** pe, int base)
 } /* UT UFE (...) */
 
 
+/* ------------------------------------------------------------------------- *\
+   UFR converts a string to an unsigned integer type and returns the value,
+   the number of converted characters and the error in a structure
+\* ------------------------------------------------------------------------- */
+
+S2N_API S2N_FLATTEN URT UFR (const char * ps, int base)
+{
+   URT    ret;
+   char * pe  = NULL;
+   int    err = 0;
+
+   ret.value = UFN (ps, &pe, base, &err);
+   ret.len   = (uint32_t) (pe - ps);
+   ret.err   = err;
+   return (ret);
+} /* URT UFR (...) */
+
+
 
 /* ------------------------------------------------------------------------- *\
    ST SFN converts a string to a signed integer type
 \* ------------------------------------------------------------------------- */
 
-ST SFN (const char * ps, char ** pe, int base, int * perr)
+S2N_API ST SFN (const char * ps, char ** pe, int base, int * perr)
 {
    ST  s_ret = 0;
    int err   = 0;
@@ -1212,6 +2093,8 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
    ST d;
    int sign = 0;
 
+   STAT_CALL(SID, base);
+
    if(!ps)
    {
       err = EINVAL;
@@ -1249,31 +2132,34 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
       else if(*ps == '0')
       {
          ++ps;
-         if(((*ps == 'x') || (*ps == 'X')) && (digit_value[(uint8_t) ps[1]] < 16))
+         if(((*ps == 'x') || (*ps == 'X')) && (DIGIT_VALUE(ps[1]) < 16))
          {
             base = 16;
             ++ps;
+            STAT_INC(prefix);
          }
-         else if(((*ps == 'b') || (*ps == 'B')) && (digit_value[(uint8_t) ps[1]] < 2))
+         else if(((*ps == 'b') || (*ps == 'B')) && (DIGIT_VALUE(ps[1]) < 2))
          {
             base = 2;
             ++ps;
+            STAT_INC(prefix);
          }
-         else if(((*ps == 'o') || (*ps == 'O')) && (digit_value[(uint8_t) ps[1]] < 2))
+         else if(((*ps == 'o') || (*ps == 'O')) && (DIGIT_VALUE(ps[1]) < 8))
          {
             base = 8;
             ++ps;
+            STAT_INC(prefix);
          }
          else if(!base)
          { /* if base is 0 than the default base after a leading 0 is 8 */
             base = 8;
-            if (digit_value[(uint8_t) *ps] >= 8)
+            if (DIGIT_VALUE(*ps) >= 8)
                goto Exit;
          }
          else
          { /* if base is 1 than the default base after a leading 0 is 10 */
             base = 10;
-            if (digit_value[(uint8_t) *ps] >= 10)
+            if (DIGIT_VALUE(*ps) >= 10)
                goto Exit;
          }
       }
@@ -1294,17 +2180,26 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
    {
       /* Care about base specifications in hex data even if base is given.
          (It's a rather dirty thing within the specification of strtoul.) */
-      if((base == 16)  && ((ps[1] == 'x') || (ps[1] == 'X')) && (digit_value[(uint8_t) ps[2]] < 16))
+      if((base == 16)  && ((ps[1] == 'x') || (ps[1] == 'X')) && (DIGIT_VALUE(ps[2]) < 16))
+      {
          ps += 2;
-      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (digit_value[(uint8_t) ps[2]] < 2))
+         STAT_INC(prefix);
+      }
+      else if((base == 2) && ((ps[1] == 'b') || (ps[1] == 'B')) && (DIGIT_VALUE(ps[2]) < 2))
+      {
          ps += 2;
-      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (digit_value[(uint8_t) ps[2]] < 8))
+         STAT_INC(prefix);
+      }
+      else if((base == 8) && ((ps[1] == 'o') || (ps[1] == 'O')) && (DIGIT_VALUE(ps[2]) < 8))
+      {
          ps += 2;
+         STAT_INC(prefix);
+      }
    }
 
    max = sign < 0 ? -min_base[base] : max_base[base];
 
-   d = digit_value[(uint8_t) *ps];
+   d = DIGIT_VALUE(*ps);
 
    if(d >= (uint8_t) base)
    {
@@ -1314,13 +2209,13 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
    }
 
    s_ret = d;
-   d = digit_value[(uint8_t)*(++ps)];
+   d = DIGIT_VALUE(*(++ps));
 
    while(d < (uint8_t) base)
    {
       if(s_ret >= max)
       {
-         if(((uint8_t) base <= digit_value[(uint8_t)*(ps+1)]) && (s_ret == max))
+         if(((uint8_t) base <= DIGIT_VALUE(*(ps+1))) && (s_ret == max))
          { /* last possibly valid digit */
             ++ps;
 
@@ -1358,14 +2253,14 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
             s_ret = S_MAX;
 #if 1
          /* Move to end of valid digits even if those exceed the range of our type */
-         while ((uint8_t) base > digit_value[(uint8_t) *(++ps)])
+         while ((uint8_t) base > DIGIT_VALUE(*(++ps)))
          {}
 #endif
          goto Exit;
       }
 
       s_ret = s_ret * base + d;
-      d = digit_value[(uint8_t)*(++ps)];
+      d = DIGIT_VALUE(*(++ps));
    }
 
    if (sign < 0)
@@ -1373,6 +2268,11 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
 
    Exit:;
 
+   STAT_ERR(err);
+
+   if(err)
+      PROBE4(error, SID, psrc, ps, err);
+
    if(perr)
       *perr = err;
 
@@ -1387,7 +2287,7 @@ ST SFN (const char * ps, char ** pe, int base, int * perr)
    SFE converts a string to an unsigned integer type
 \* ------------------------------------------------------------------------- */
 
-ST SFE (const char * ps, char ** pe, int base)
+S2N_API ST SFE (const char * ps, char ** pe, int base)
 {
    int err;
    ST  s_ret = SFN (ps, pe, base, &err);
@@ -1397,8 +2297,30 @@ ST SFE (const char * ps, char ** pe, int base)
 }/* ST SFE(...) */
 
 
+/* ------------------------------------------------------------------------- *\
+   SFR converts a string to a signed integer type and returns the value, the
+   number of converted characters and the error in a structure
+\* ------------------------------------------------------------------------- */
+
+S2N_API S2N_FLATTEN SRT SFR (const char * ps, int base)
+{
+   SRT    ret;
+   char * pe  = NULL;
+   int    err = 0;
+
+   ret.value = SFN (ps, &pe, base, &err);
+   ret.len   = (uint32_t) (pe - ps);
+   ret.err   = err;
+   return (ret);
+} /* SRT SFR (...) */
+
+
 #undef SFE
 #undef UFE
+#undef SFR
+#undef UFR
+#undef SRT
+#undef URT
 #undef SFN
 #undef UFN
 #undef UT
@@ -1406,6 +2328,8 @@ ST SFE (const char * ps, char ** pe, int base)
 #undef U_MAX
 #undef S_MAX
 #undef S_MIN
+#undef SID
+#undef UID
 
 #endif /* STR2NUM_C */
 
@@ -62,12 +62,110 @@
 #define S2N_USE_POW10_ARRAY 1
 #endif
 
+#ifndef S2N_USE_DIGIT_TABLE
+/* If S2N_USE_DIGIT_TABLE is nonzero then the values of the digits are looked up in the
+   256 byte table digit_value. Otherwise they are computed by a few comparisons which
+   avoids cache misses of the table if numbers are converted just occasionally between
+   lots of other work. The table digit_value is exported in either case. */
+
+#define S2N_USE_DIGIT_TABLE 1
+#endif
+
+#ifndef S2N_STATS
+/* If S2N_STATS is nonzero then the functions count their calls and the paths that they take
+   in thread local counters which can be read by str2num_stats. This shows which slow paths
+   the real data hits but costs an increment of a thread local variable on each of them. */
+
+#define S2N_STATS 0
+#endif
+
+#ifndef S2N_USDT
+/* If S2N_USDT is nonzero then str2num.c and str2num_batch.c contain static tracepoints of
+   systemtap (sys/sdt.h) for errors, truncated mantissas, split powers and the buffers of
+   the batch functions which can be traced with bpftrace or perf. The probes are just a nop
+   instruction as long as no tracer is attached and there is no runtime dependency. */
+
+#define S2N_USDT 0
+#endif
+
+#ifndef S2N_HEADER_ONLY
+/* If S2N_HEADER_ONLY is nonzero then str2num.h includes str2num.c and all functions are
+   static inline. The compiler can inline the conversions into the calling loops then and
+   drop the stores of NULL pointers for pe and perr or optimize constant bases. Each file
+   that includes str2num.h gets its own copy of the used functions and of the counters of
+   S2N_STATS, and str2num.c needs not to be linked unless other modules require it. */
+
+#define S2N_HEADER_ONLY 0
+#endif
+
+#if S2N_HEADER_ONLY
+#define S2N_API  static inline
+#define S2N_DATA static
+#else
+#define S2N_API
+#define S2N_DATA
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if !S2N_HEADER_ONLY
 /* table for fast decoding ascii encoded numbers e.g. if (Digit[(uint8_t) c] < 10) i = Digit[(uint8_t) c]; */
 extern const uint8_t digit_value[256];
+#endif
+
+/* indices of the functions in the calls of s2n_stats */
+#define S2N_STAT_I64    0  /* str2i64_r */
+#define S2N_STAT_U64    1  /* str2u64_r */
+#define S2N_STAT_I32    2  /* str2i32_r */
+#define S2N_STAT_U32    3  /* str2u32_r */
+#define S2N_STAT_I16    4  /* str2i16_r */
+#define S2N_STAT_U16    5  /* str2u16_r */
+#define S2N_STAT_I8     6  /* str2i8_r  */
+#define S2N_STAT_U8     7  /* str2u8_r  */
+#define S2N_STAT_PD     8  /* str2pd_r  */
+#define S2N_STAT_SZ     9  /* str2sz_r  */
+#define S2N_STAT_IP    10  /* str2ip_r  */
+#define S2N_STAT_UP    11  /* str2up_r  */
+#define S2N_STAT_I     12  /* str2i_r   */
+#define S2N_STAT_U     13  /* str2u_r   */
+#define S2N_STAT_L     14  /* str2l_r   */
+#define S2N_STAT_UL    15  /* str2ul_r  */
+#define S2N_STAT_LL    16  /* str2ll_r  */
+#define S2N_STAT_ULL   17  /* str2ull_r */
+#define S2N_STAT_LD    18  /* str2ld_r  */
+#define S2N_STAT_D     19  /* str2d_r   */
+#define S2N_STAT_FUNCS 20  /* number of counted functions */
+
+/* counters of the conversion functions if compiled with S2N_STATS
+   The wrappers that set errno are counted as the *_r function which they call.
+   The base 37 counts the calls with an invalid base argument. */
+typedef struct s2n_stats_s s2n_stats;
+struct s2n_stats_s
+{
+   uint64_t calls[S2N_STAT_FUNCS][38]; /* calls of each function for each base argument */
+   uint64_t pow10;                     /* floating point values scaled by the array of powers of 10 */
+   uint64_t powi;                      /* floating point values scaled by a computed power of the base */
+   uint64_t split;                     /* floating point values which power of a negative exponent got split */
+   uint64_t truncated;                 /* digits of floating point values which exceeded the mantissa */
+   uint64_t prefix;                    /* numbers with a prefix 0x, 0b or 0o */
+   uint64_t inf;                       /* infinite floating point values */
+   uint64_t nan;                       /* floating point values that are NaN */
+   uint64_t range;                     /* integers that returned ERANGE */
+   uint64_t invalid;                   /* calls that returned EINVAL */
+};
+
+/* str2num_stats copies the counters of the calling thread to *pstats. It returns 0 or
+   ENOSYS if str2num.c was compiled without S2N_STATS. */
+S2N_API int  str2num_stats       (s2n_stats * pstats);
+
+/* str2num_stats_reset clears the counters of the calling thread. */
+S2N_API void str2num_stats_reset (void);
+
+/* str2num_stats_add adds the counters of *pstats to *psum e.g. for collecting the
+   snapshots of several threads. */
+S2N_API void str2num_stats_add   (s2n_stats * psum, const s2n_stats * pstats);
 
 /* The functions are full featured wrappers for strtol or strtoul like functions. 
    All functions return the minimum or maximum value of the integer type in case of overflows.  
@@ -77,72 +175,205 @@ extern const uint8_t digit_value[256];
    the prefix 0o for being recognized as octal values.
    Octal floating point values always require the prefix 0o for an automatic detection of that base. */
 
- int64_t str2i64_r (const char * ps, char ** pe, int base, int * perr);
-uint64_t str2u64_r (const char * ps, char ** pe, int base, int * perr);
- int64_t str2i64   (const char * ps, char ** pe, int base);
-uint64_t str2u64   (const char * ps, char ** pe, int base);
+S2N_API  int64_t str2i64_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API uint64_t str2u64_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API  int64_t str2i64   (const char * ps, char ** pe, int base);
+S2N_API uint64_t str2u64   (const char * ps, char ** pe, int base);
 
- int32_t str2i32_r (const char * ps, char ** pe, int base, int * perr);
-uint32_t str2u32_r (const char * ps, char ** pe, int base, int * perr);
- int32_t str2i32   (const char * ps, char ** pe, int base);
-uint32_t str2u32   (const char * ps, char ** pe, int base);
+S2N_API  int32_t str2i32_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API uint32_t str2u32_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API  int32_t str2i32   (const char * ps, char ** pe, int base);
+S2N_API uint32_t str2u32   (const char * ps, char ** pe, int base);
 
- int16_t str2i16_r (const char * ps, char ** pe, int base, int * perr);
-uint16_t str2u16_r (const char * ps, char ** pe, int base, int * perr);
- int16_t str2i16   (const char * ps, char ** pe, int base);
-uint16_t str2u16   (const char * ps, char ** pe, int base);
+S2N_API  int16_t str2i16_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API uint16_t str2u16_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API  int16_t str2i16   (const char * ps, char ** pe, int base);
+S2N_API uint16_t str2u16   (const char * ps, char ** pe, int base);
 
- int8_t  str2i8_r  (const char * ps, char ** pe, int base, int * perr);
-uint8_t  str2u8_r  (const char * ps, char ** pe, int base, int * perr);
- int8_t  str2i8    (const char * ps, char ** pe, int base);
-uint8_t  str2u8    (const char * ps, char ** pe, int base);
+S2N_API  int8_t  str2i8_r  (const char * ps, char ** pe, int base, int * perr);
+S2N_API uint8_t  str2u8_r  (const char * ps, char ** pe, int base, int * perr);
+S2N_API  int8_t  str2i8    (const char * ps, char ** pe, int base);
+S2N_API uint8_t  str2u8    (const char * ps, char ** pe, int base);
 
-ptrdiff_t str2pd_r (const char * ps, char ** pe, int base, int * perr);
-size_t    str2sz_r (const char * ps, char ** pe, int base, int * perr);
-ptrdiff_t str2pd   (const char * ps, char ** pe, int base);
-size_t    str2sz   (const char * ps, char ** pe, int base);
+S2N_API ptrdiff_t str2pd_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API size_t    str2sz_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API ptrdiff_t str2pd   (const char * ps, char ** pe, int base);
+S2N_API size_t    str2sz   (const char * ps, char ** pe, int base);
 
- intptr_t str2ip_r (const char * ps, char ** pe, int base, int * perr);
-uintptr_t str2up_r (const char * ps, char ** pe, int base, int * perr);
- intptr_t str2ip   (const char * ps, char ** pe, int base);
-uintptr_t str2up   (const char * ps, char ** pe, int base);
+S2N_API  intptr_t str2ip_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API uintptr_t str2up_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API  intptr_t str2ip   (const char * ps, char ** pe, int base);
+S2N_API uintptr_t str2up   (const char * ps, char ** pe, int base);
 
-         int str2i_r (const char * ps, char ** pe, int base, int * perr);
-unsigned int str2u_r (const char * ps, char ** pe, int base, int * perr);
-         int str2i   (const char * ps, char ** pe, int base);
-unsigned int str2u   (const char * ps, char ** pe, int base);
+S2N_API          int str2i_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API unsigned int str2u_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API          int str2i   (const char * ps, char ** pe, int base);
+S2N_API unsigned int str2u   (const char * ps, char ** pe, int base);
 
-         long str2l_r  (const char * ps, char ** pe, int base, int * perr);
-unsigned long str2ul_r (const char * ps, char ** pe, int base, int * perr);
-         long str2l    (const char * ps, char ** pe, int base);
-unsigned long str2ul   (const char * ps, char ** pe, int base);
+S2N_API          long str2l_r  (const char * ps, char ** pe, int base, int * perr);
+S2N_API unsigned long str2ul_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API          long str2l    (const char * ps, char ** pe, int base);
+S2N_API unsigned long str2ul   (const char * ps, char ** pe, int base);
 
-         long long str2ll_r  (const char * ps, char ** pe, int base, int * perr);
-unsigned long long str2ull_r (const char * ps, char ** pe, int base, int * perr);
-         long long str2ll    (const char * ps, char ** pe, int base);
-unsigned long long str2ull   (const char * ps, char ** pe, int base);
+S2N_API          long long str2ll_r  (const char * ps, char ** pe, int base, int * perr);
+S2N_API unsigned long long str2ull_r (const char * ps, char ** pe, int base, int * perr);
+S2N_API          long long str2ll    (const char * ps, char ** pe, int base);
+S2N_API unsigned long long str2ull   (const char * ps, char ** pe, int base);
 
 
 /* r_str2ld reads a long double from a string and cares about a specified base. */
-long double str2ld_r (const char * psrc, char ** pend, int base, int * perr);
+S2N_API long double str2ld_r (const char * psrc, char ** pend, int base, int * perr);
 
 /* r_str2d reads a double from a string and cares about a specified base. */
-double      str2d_r  (const char * psrc, char ** pend, int base, int * perr);
+S2N_API double      str2d_r  (const char * psrc, char ** pend, int base, int * perr);
 
 /* str2ld is a wrapper for strtold that calls r_str2ld for reading long doubles. */
-long double str2ld   (const char * psrc, char ** pend);
+S2N_API long double str2ld   (const char * psrc, char ** pend);
 
 /* str2d is a wrapper for strtod that calls r_str2d for reading doubles. */
-double      str2d    (const char * psrc, char ** pend);
+S2N_API double      str2d    (const char * psrc, char ** pend);
 
 /* str2f is a wrapper for strtof that calls r_str2d for reading floats. */
-float       str2f    (const char * psrc, char ** pend);
+S2N_API float       str2f    (const char * psrc, char ** pend);
+
+
+/* The *_ret functions work like the *_r functions but return the value, the number of
+   converted characters and the error in a structure instead of storing the end position
+   and the error by pointers. The structures of all integers and of double have 16 bytes
+   at most and are returned in two registers by the x86-64 and AArch64 calling conventions
+   (the one of long double is returned in memory). The end of a conversion is ps + len.
+   The length is truncated to 32 bits and the functions are meant for numbers of less
+   than 4 GB. */
+
+#define S2N_RET(name, type) typedef struct name##_s name; struct name##_s { type value; uint32_t len; int32_t err; }
+
+S2N_RET(s2n_ret_i64, int64_t);
+S2N_RET(s2n_ret_u64, uint64_t);
+S2N_RET(s2n_ret_i32, int32_t);
+S2N_RET(s2n_ret_u32, uint32_t);
+S2N_RET(s2n_ret_i16, int16_t);
+S2N_RET(s2n_ret_u16, uint16_t);
+S2N_RET(s2n_ret_i8,  int8_t);
+S2N_RET(s2n_ret_u8,  uint8_t);
+S2N_RET(s2n_ret_pd,  ptrdiff_t);
+S2N_RET(s2n_ret_sz,  size_t);
+S2N_RET(s2n_ret_ip,  intptr_t);
+S2N_RET(s2n_ret_up,  uintptr_t);
+S2N_RET(s2n_ret_i,   int);
+S2N_RET(s2n_ret_u,   unsigned int);
+S2N_RET(s2n_ret_l,   long);
+S2N_RET(s2n_ret_ul,  unsigned long);
+S2N_RET(s2n_ret_ll,  long long);
+S2N_RET(s2n_ret_ull, unsigned long long);
+S2N_RET(s2n_ret_d,   double);
+S2N_RET(s2n_ret_ld,  long double);
+
+#undef S2N_RET
+
+S2N_API s2n_ret_i64 str2i64_ret (const char * ps, int base);
+S2N_API s2n_ret_u64 str2u64_ret (const char * ps, int base);
+S2N_API s2n_ret_i32 str2i32_ret (const char * ps, int base);
+S2N_API s2n_ret_u32 str2u32_ret (const char * ps, int base);
+S2N_API s2n_ret_i16 str2i16_ret (const char * ps, int base);
+S2N_API s2n_ret_u16 str2u16_ret (const char * ps, int base);
+S2N_API s2n_ret_i8  str2i8_ret  (const char * ps, int base);
+S2N_API s2n_ret_u8  str2u8_ret  (const char * ps, int base);
+S2N_API s2n_ret_pd  str2pd_ret  (const char * ps, int base);
+S2N_API s2n_ret_sz  str2sz_ret  (const char * ps, int base);
+S2N_API s2n_ret_ip  str2ip_ret  (const char * ps, int base);
+S2N_API s2n_ret_up  str2up_ret  (const char * ps, int base);
+S2N_API s2n_ret_i   str2i_ret   (const char * ps, int base);
+S2N_API s2n_ret_u   str2u_ret   (const char * ps, int base);
+S2N_API s2n_ret_l   str2l_ret   (const char * ps, int base);
+S2N_API s2n_ret_ul  str2ul_ret  (const char * ps, int base);
+S2N_API s2n_ret_ll  str2ll_ret  (const char * ps, int base);
+S2N_API s2n_ret_ull str2ull_ret (const char * ps, int base);
+S2N_API s2n_ret_d   str2d_ret   (const char * psrc, int base);
+S2N_API s2n_ret_ld  str2ld_ret  (const char * psrc, int base);
+
+
+/* flags of s2n_lazy */
+#define S2N_LAZY_NEG      0x0001  /* the number starts with a '-' */
+#define S2N_LAZY_SIGN     0x0002  /* the number starts with a '-' or '+' */
+#define S2N_LAZY_FRAC     0x0004  /* the number has a fraction or an exponent */
+#define S2N_LAZY_MAG      0x0010  /* mag holds the converted magnitude of an integer */
+#define S2N_LAZY_MAG_ERR  0x0020  /* the magnitude exceeds uint64_t */
+#define S2N_LAZY_D        0x0040  /* d holds the converted double */
+#define S2N_LAZY_FIX      0x0080  /* fix holds the converted fixed point value of scale */
+#define S2N_LAZY_FIX_ERR  0x0100  /* the fixed point value exceeds int64_t */
+
+/* lazy token of a decimal number that is converted on the first access only */
+typedef struct s2n_lazy_s s2n_lazy;
+struct s2n_lazy_s
+{
+   const char * ps;    /* first character of the number */
+   uint32_t     len;   /* number of characters of the number */
+   uint16_t     flags; /* S2N_LAZY_* flags */
+   int16_t      scale; /* number of decimal places of fix */
+   uint64_t     mag;   /* cached magnitude of an integer */
+   double       d;     /* cached double value */
+   int64_t      fix;   /* cached fixed point value */
+};
+
+/* s2n_lazy_scan validates a decimal number at ps in the format of JSON with an optional
+   '+' sign without converting it and stores its position in *pl. Leading blanks are
+   skipped. The end of the number is stored in *pe and the function returns 0 or EINVAL
+   (also for NULL pointers).
+   The characters of the number must stay unchanged as long as the token is used. */
+S2N_API int s2n_lazy_scan (s2n_lazy * pl, const char * ps, char ** pe);
+
+/* The s2n_lazy_* functions convert the number of a token on the first call, cache the
+   result in the token and return it in *pv on further calls without reading the number
+   again. They return 0 or ERANGE and the minimum or maximum value like the *_r functions.
+   s2n_lazy_i64 and s2n_lazy_u64 return EINVAL for numbers with a fraction or an exponent.
+   All of them return EINVAL and 0 for a NULL token or a token of an invalid number.
+   s2n_lazy_fix returns the number multiplied by 10^scale and truncated towards 0 for a
+   scale of 0 - 18 decimal places or EINVAL for other scales. The cache of fix keeps the
+   value of the last scale only. */
+S2N_API int s2n_lazy_i64  (s2n_lazy * pl, int64_t  * pv);
+S2N_API int s2n_lazy_u64  (s2n_lazy * pl, uint64_t * pv);
+S2N_API int s2n_lazy_d    (s2n_lazy * pl, double   * pv);
+S2N_API int s2n_lazy_fix  (s2n_lazy * pl, int scale, int64_t * pv);
+
+
+/* types of s2n_any */
+#define S2N_ANY_ERR  0  /* the string isn't a number, err holds the error */
+#define S2N_ANY_I64  1  /* value.i64 holds an integer */
+#define S2N_ANY_U64  2  /* value.u64 holds a positive integer above INT64_MAX */
+#define S2N_ANY_D    3  /* value.d holds a number with a fraction, an exponent or out of range */
+
+/* number of a type that is known after reading only */
+typedef struct s2n_any_s s2n_any;
+struct s2n_any_s
+{
+   union
+   {
+      int64_t  i64;
+      uint64_t u64;
+      double   d;
+   } value;
+   uint32_t len;  /* number of converted characters */
+   int16_t  type; /* S2N_ANY_* type */
+   int16_t  err;  /* 0 or EINVAL */
+};
+
+/* str2num_any reads a number in a single pass and returns an integer as int64_t, a
+   positive integer above INT64_MAX as uint64_t and numbers with a fraction or an exponent,
+   integers out of these ranges, "inf" and "nan" as double like str2d_r. Bases 0 and 1
+   detect the base like str2d_r, so leading zeros are decimal like base 1 of the integer
+   functions. The structure has 16 bytes and is returned in two registers like the *_ret
+   functions. */
+S2N_API s2n_any str2num_any (const char * psrc, int base);
 
 
 #ifdef __cplusplus
 }/* extern "C" */
 #endif
 
+#if S2N_HEADER_ONLY && !defined(STR2NUM_C)
+#include "str2num.c"
+#endif
+
 #endif /* STR2NUM_H */
 
 /* ========================================================================= *\
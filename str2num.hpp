@@ -0,0 +1,1248 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num.hpp                                                  *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : C++ interface of the conversion functions of str2num.c       *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#ifndef STR2NUM_HPP
+#define STR2NUM_HPP
+
+
+#include <array>
+#include <cerrno>
+#include <charconv>     /* std::from_chars_result */
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if (__cplusplus >= 202002L) || (defined (_MSVC_LANG) && (_MSVC_LANG >= 202002L))
+#include <iterator>
+#include <ranges>
+#endif
+
+#include <str2num.h>
+
+/* The templates are always inlined so that the compiler can propagate constant arguments. */
+#if defined (__GNUC__)
+#define S2N_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined (_MSC_VER)
+#define S2N_FORCE_INLINE __forceinline
+#else
+#define S2N_FORCE_INLINE inline
+#endif
+
+
+/* s2n::str2int_r is a native template of the integer conversion functions of str2num.c
+   for the characters of the range ps - pend. It works like the *_r functions but stores
+   the end position in *ppe and never reads behind pend. If the template argument BASE is
+   0 then the argument base is used like the C functions do including the detection of the
+   base for the values 0 and 1. A BASE of 2 - 36 is a fixed base that ignores the argument
+   and lets the compiler optimize the loop for that base.
+   T may be any integer type or a literal class type that provides the arithmetic and
+   comparison operators of an integer, a constructor for int values and a specialization
+   of std::numeric_limits with is_signed, min() and max() e.g. for strong typedefs. */
+
+/* s2n::str2flt_r is a native template of str2d_r for float and double and of str2ld_r for
+   long double that works on the range ps - pend like s2n::str2int_r. The results are the
+   same as those of the C functions if str2num.c is compiled with the same options. */
+
+/* All templates are constexpr and can be evaluated at compile time. They never touch errno
+   and use the table digit_table of this header instead of digit_value of str2num.c. */
+
+/* s2n::from_chars converts the characters of the range first - last like std::from_chars
+   but with the syntax of the str2num functions. That means leading blanks, a '+' sign and
+   the prefixes 0x, 0b and 0o are accepted and a '-' for unsigned types negates the value.
+   If base is 0 or 1 then the base is detected like the C functions do. The integer
+   overloads use s2n::str2int_r and s2n::from_chars<BASE> converts values of a fixed base.
+   The floating point overloads use s2n::str2flt_r. The characters behind last are never
+   read and errno is never touched.
+   ptr of the result points behind the converted characters and ec is std::errc() in case of
+   success. If the range doesn't start with a valid number then ptr is first and ec is
+   std::errc::invalid_argument. If the value is out of range then ptr points behind the
+   digits and ec is std::errc::result_out_of_range. value is only set in case of success. */
+
+/* s2n::numbers<T> is a lazy C++20 view of the numbers of a buffer that are separated by the
+   delimiter delim like the fields of str2num_batch.h. The fields are found and converted
+   by the iterators while the view is traversed without any allocation or copy. A delimiter
+   at the very end of the buffer doesn't start another field and leading and trailing blanks
+   of the fields are ignored. The iterators return the values by value, 0 for invalid fields
+   and the minimum or maximum value for integers out of range. error() of an iterator returns the std::errc of
+   the current field and text() its characters. The view is a borrowed forward range that
+   composes with std::views::filter, std::views::transform, std::views::take and others. */
+
+/* The user defined literals _b2 - _b36 of the namespace s2n::literals convert a string
+   literal of the given numeric base to an unsigned long long e.g. "zz"_b36 is 1295. The
+   literals must consist of digits of the base only without blanks, signs or prefixes.
+   Invalid literals and values out of range are errors at compile time if the literal is
+   used in a constant expression and throw std::invalid_argument or std::out_of_range
+   otherwise. */
+
+namespace s2n
+{
+
+using from_chars_result = std::from_chars_result;
+
+namespace detail
+{
+
+/* ------------------------------------------------------------------------- *\
+   make_digits creates a table like digit_value of str2num.c at compile time.
+\* ------------------------------------------------------------------------- */
+
+constexpr std::array<uint8_t, 256> make_digits()
+{
+   std::array<uint8_t, 256> a {};
+
+   for(unsigned c = 0; c < 256; ++c)
+   {
+      if((c >= '0') && (c <= '9'))
+         a[c] = (uint8_t) (c - '0');
+      else if(((c | 0x20) >= 'a') && ((c | 0x20) <= 'z'))
+         a[c] = (uint8_t) ((c | 0x20) - 'a' + 10);
+      else
+         a[c] = 64;
+   }
+
+   return (a);
+} /* std::array<uint8_t, 256> make_digits() */
+
+/* table of the values of the digits that can be used at compile time */
+inline constexpr std::array<uint8_t, 256> digit_table = make_digits();
+
+
+/* ------------------------------------------------------------------------- *\
+   digit returns the value of the digit ps[k] of the table digit_table or 64
+   if the index k is not within the range ps - pend.
+\* ------------------------------------------------------------------------- */
+
+S2N_FORCE_INLINE constexpr unsigned digit(const char * ps, const char * pend, ptrdiff_t k)
+{
+   return ((pend - ps > k) ? digit_table[(uint8_t) ps[k]] : 64u);
+} /* unsigned digit(const char * ps, const char * pend, ptrdiff_t k) */
+
+
+/* ------------------------------------------------------------------------- *\
+   at returns the character ps[k] or 0 like the terminating 0 of a string if
+   the index k is not within the range ps - pend.
+\* ------------------------------------------------------------------------- */
+
+S2N_FORCE_INLINE constexpr char at(const char * ps, const char * pend, ptrdiff_t k)
+{
+   return ((pend - ps > k) ? ps[k] : '\0');
+} /* char at(const char * ps, const char * pend, ptrdiff_t k) */
+
+
+/* ------------------------------------------------------------------------- *\
+   limits provides the maxima of the values before the last digit for all
+   numeric bases like the max_base and min_base tables of str2num.c and the
+   number of digits that can't overflow.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+struct limits
+{
+   static constexpr std::array<T, 37> make(bool neg)
+   {
+      std::array<T, 37> a {};
+
+      for(int b = 2; b <= 36; ++b)
+         a[b] = neg ? T(-(std::numeric_limits<T>::min() / T(b))) : T(std::numeric_limits<T>::max() / T(b));
+
+      return (a);
+   }
+
+   static constexpr std::array<int, 37> make_safe()
+   {
+      std::array<int, 37> a {};
+
+      for(int b = 2; b <= 36; ++b)
+      {
+         T p = std::numeric_limits<T>::max();
+
+         while(p >= T(b))
+         {
+            p = T(p / T(b));
+            ++a[b];
+         }
+      }
+
+      return (a);
+   }
+
+   static constexpr std::array<int, 37> safe     = make_safe();                                /* digits that can't overflow */
+   static constexpr std::array<T, 37>   max_base = make(false);                               /* maximum / base */
+   static constexpr std::array<T, 37>   neg_base = make(std::numeric_limits<T>::is_signed);   /* -(minimum / base) */
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   prefix skips the blanks, the sign and the prefix of a number and detects
+   the base. It returns 0 for a number, 1 for a single '0' that is followed by
+   an invalid digit of base 0 or 1 and EINVAL for invalid arguments.
+\* ------------------------------------------------------------------------- */
+
+template <int BASE>
+S2N_FORCE_INLINE constexpr int prefix(const char *& ps, const char * pend, int & base, int & sign)
+{
+   if constexpr (BASE)
+      base = BASE;
+
+   while((ps < pend) && ((*ps == ' ') || ((*ps >= 0x9) && (*ps <= 0xd))))
+      ++ps;
+
+   if((ps < pend) && (*ps == '+'))
+   {
+      sign = 1;
+      ++ps;
+   }
+   else if((ps < pend) && (*ps == '-'))
+   {
+      sign = -1;
+      ++ps;
+   }
+
+   if((ps >= pend) || (base < 0) || (base > 36))
+      return (EINVAL);
+
+   if(!BASE && (base < 2))
+   { /* let's detect the base */
+      if((*ps > '0') && (*ps <= '9'))
+      {
+         base = 10;
+      }
+      else if(*ps == '0')
+      {
+         ++ps;
+         if((ps < pend) && ((*ps | 0x20) == 'x') && (digit(ps, pend, 1) < 16))
+         {
+            base = 16;
+            ++ps;
+         }
+         else if((ps < pend) && ((*ps | 0x20) == 'b') && (digit(ps, pend, 1) < 2))
+         {
+            base = 2;
+            ++ps;
+         }
+         else if((ps < pend) && ((*ps | 0x20) == 'o') && (digit(ps, pend, 1) < 8))
+         {
+            base = 8;
+            ++ps;
+         }
+         else
+         { /* the default base after a leading 0 is 8 if base is 0 and 10 if base is 1 */
+            base = base ? 10 : 8;
+            if(digit(ps, pend, 0) >= (unsigned) base)
+               return (1);
+         }
+      }
+      else
+      {
+         return (EINVAL);
+      }
+   }
+   else if(*ps == '0')
+   {
+      /* Care about base specifications in hex data even if base is given.
+         (It's a rather dirty thing within the specification of strtoul.) */
+      if((base == 16) && (pend - ps > 1) && ((ps[1] | 0x20) == 'x') && (digit(ps, pend, 2) < 16))
+         ps += 2;
+      else if((base == 2) && (pend - ps > 1) && ((ps[1] | 0x20) == 'b') && (digit(ps, pend, 2) < 2))
+         ps += 2;
+      else if((base == 8) && (pend - ps > 1) && ((ps[1] | 0x20) == 'o') && (digit(ps, pend, 2) < 8))
+         ps += 2;
+   }
+
+   return (0);
+} /* int prefix(const char *& ps, const char * pend, int & base, int & sign) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2uint converts a range to an unsigned integer type like UFN of str2num.c.
+   It returns the error value and leaves ps behind the converted characters.
+   The early returns replace the goto Exit of str2num.c which isn't allowed
+   in constexpr functions.
+\* ------------------------------------------------------------------------- */
+
+template <typename T, int BASE>
+S2N_FORCE_INLINE constexpr int str2uint(const char *& ps, const char * pend, int base, T & u_ret)
+{
+   const T  u_max = std::numeric_limits<T>::max();
+   T        max   = T(0);
+   unsigned d     = 0;
+   int      sign  = 0;
+   int      err   = prefix<BASE>(ps, pend, base, sign);
+
+   if(err)
+      return ((err == EINVAL) ? EINVAL : 0); /* 1 is just a 0 */
+
+   if constexpr (BASE)
+      max = T(u_max / T(BASE));
+   else
+      max = limits<T>::max_base[base];
+
+   d = digit(ps, pend, 0);
+   if(d >= (unsigned) base)
+      return (EINVAL);
+
+   u_ret = T(d);
+   ++ps;
+
+   { /* the digits before the last one of the maximum can't overflow and need no range check */
+      const int    n     = BASE ? limits<T>::safe[BASE] - 1 : limits<T>::safe[base] - 1;
+      const char * psafe = (pend - ps > n) ? ps + n : pend;
+
+      while((ps < psafe) && ((d = digit_table[(uint8_t) *ps]) < (unsigned) base))
+      {
+         u_ret = T(u_ret * T(base) + T(d));
+         ++ps;
+      }
+   }
+
+   d = digit(ps, pend, 0);
+
+   while(d < (unsigned) base)
+   {
+      if(u_ret >= max)
+      {
+         if(((unsigned) base > digit(ps, pend, 1)) || (u_ret > max) || (T(u_ret * T(base)) > T(u_max - T(d))))
+         {
+#if S2N_UMIN_IS_SMIN
+            if(sign < 0)
+               u_ret = T(u_max / T(2) + T(1)); /* negative value exceeds the minimum of a signed type of that width */
+            else
+#endif
+               u_ret = u_max;
+
+            /* Move to end of valid digits even if those exceed the range of our type. */
+            while((unsigned) base > digit(++ps, pend, 0))
+            {}
+            return (ERANGE); /* indicate overflow error */
+         }
+      }
+
+      u_ret = T(u_ret * T(base) + T(d));
+      d = digit(++ps, pend, 0);
+   }
+
+   if(sign < 0)
+   {
+#if S2N_UMIN_IS_SMIN
+      if(u_ret > T(u_max / T(2) + T(1)))
+      { /* The negative value exceeds the minimum of a signed type of that width. */
+         u_ret = T(u_max / T(2) + T(1));
+         return (ERANGE);
+      }
+#endif
+      u_ret = T(T(0) - u_ret); /* negate the result */
+   }
+
+   return (0);
+} /* int str2uint(const char *& ps, const char * pend, int base, T & u_ret) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2sint converts a range to a signed integer type like SFN of str2num.c.
+   It returns the error value and leaves ps behind the converted characters.
+\* ------------------------------------------------------------------------- */
+
+template <typename T, int BASE>
+S2N_FORCE_INLINE constexpr int str2sint(const char *& ps, const char * pend, int base, T & s_ret)
+{
+   const T  s_max = std::numeric_limits<T>::max();
+   const T  s_min = std::numeric_limits<T>::min();
+   T        max   = T(0);
+   unsigned d     = 0;
+   int      sign  = 0;
+   int      err   = prefix<BASE>(ps, pend, base, sign);
+
+   if(err)
+      return ((err == EINVAL) ? EINVAL : 0); /* 1 is just a 0 */
+
+   if constexpr (BASE)
+      max = (sign < 0) ? T(-(s_min / T(BASE))) : T(s_max / T(BASE));
+   else
+      max = (sign < 0) ? limits<T>::neg_base[base] : limits<T>::max_base[base];
+
+   d = digit(ps, pend, 0);
+   if(d >= (unsigned) base)
+      return (EINVAL);
+
+   s_ret = T(d);
+   ++ps;
+
+   { /* the digits before the last one of the maximum can't overflow and need no range check */
+      const int    n     = BASE ? limits<T>::safe[BASE] - 1 : limits<T>::safe[base] - 1;
+      const char * psafe = (pend - ps > n) ? ps + n : pend;
+
+      while((ps < psafe) && ((d = digit_table[(uint8_t) *ps]) < (unsigned) base))
+      {
+         s_ret = T(s_ret * T(base) + T(d));
+         ++ps;
+      }
+   }
+
+   d = digit(ps, pend, 0);
+
+   while(d < (unsigned) base)
+   {
+      if(s_ret >= max)
+      {
+         if(((unsigned) base <= digit(ps, pend, 1)) && (s_ret == max))
+         { /* last possibly valid digit */
+            ++ps;
+
+            if(sign < 0)
+            { /* negative value */
+               s_ret = T(s_ret * T(-base));
+               if(s_ret < T(s_min + T(d)))
+               {
+                  s_ret = s_min;
+                  return (ERANGE); /* indicate overflow error */
+               }
+               s_ret = T(s_ret - T(d));
+            }
+            else
+            {
+               s_ret = T(s_ret * T(base));
+               if(s_ret > T(s_max - T(d)))
+               {
+                  s_ret = s_max;
+                  return (ERANGE); /* indicate overflow error */
+               }
+               s_ret = T(s_ret + T(d));
+            }
+            return (0);
+         }
+
+         s_ret = (sign < 0) ? s_min : s_max;
+
+         /* Move to end of valid digits even if those exceed the range of our type */
+         while((unsigned) base > digit(++ps, pend, 0))
+         {}
+         return (ERANGE); /* indicate overflow error */
+      }
+
+      s_ret = T(s_ret * T(base) + T(d));
+      d = digit(++ps, pend, 0);
+   }
+
+   if(sign < 0)
+      s_ret = T(-s_ret);
+
+   return (0);
+} /* int str2sint(const char *& ps, const char * pend, int base, T & s_ret) */
+
+
+/* ------------------------------------------------------------------------- *\
+   errc converts an error value of the str2num functions to a std::errc.
+\* ------------------------------------------------------------------------- */
+
+constexpr std::errc errc(int err)
+{
+   if(!err)
+      return (std::errc());
+
+   return ((err == ERANGE) ? std::errc::result_out_of_range : std::errc::invalid_argument);
+} /* std::errc errc(int err) */
+
+
+#if S2N_USE_POW10_ARRAY
+/* the powers of 10 of str2d_r */
+inline constexpr double pow10d[] = { 1e-99, 1e-98, 1e-97, 1e-96, 1e-95, 1e-94, 1e-93, 1e-92, 1e-91, 1e-90,
+                                     1e-89, 1e-88, 1e-87, 1e-86, 1e-85, 1e-84, 1e-83, 1e-82, 1e-81, 1e-80,
+                                     1e-79, 1e-78, 1e-77, 1e-76, 1e-75, 1e-74, 1e-73, 1e-72, 1e-71, 1e-70,
+                                     1e-69, 1e-68, 1e-67, 1e-66, 1e-65, 1e-64, 1e-63, 1e-62, 1e-61, 1e-60,
+                                     1e-59, 1e-58, 1e-57, 1e-56, 1e-55, 1e-54, 1e-53, 1e-52, 1e-51, 1e-50,
+                                     1e-49, 1e-48, 1e-47, 1e-46, 1e-45, 1e-44, 1e-43, 1e-42, 1e-41, 1e-40,
+                                     1e-39, 1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31, 1e-30,
+                                     1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21, 1e-20,
+                                     1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10,
+                                     1e-09, 1e-08, 1e-07, 1e-06, 1e-05, 1e-04, 1e-03, 1e-02, 1e-01,
+                                      1e00,  1e01,  1e02,  1e03,  1e04,  1e05,  1e06,  1e07,  1e08,  1e09,
+                                      1e10,  1e11,  1e12,  1e13,  1e14,  1e15,  1e16,  1e17,  1e18,  1e19,
+                                      1e20,  1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,  1e28,  1e29,
+                                      1e30,  1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,  1e39,
+                                      1e40,  1e41,  1e42,  1e43,  1e44,  1e45,  1e46,  1e47,  1e48,  1e49,
+                                      1e50,  1e51,  1e52,  1e53,  1e54,  1e55,  1e56,  1e57,  1e58,  1e59,
+                                      1e60,  1e61,  1e62,  1e63,  1e64,  1e65,  1e66,  1e67,  1e68,  1e69,
+                                      1e70,  1e71,  1e72,  1e73,  1e74,  1e75,  1e76,  1e77,  1e78,  1e79,
+                                      1e80,  1e81,  1e82,  1e83,  1e84,  1e85,  1e86,  1e87,  1e88,  1e89,
+                                      1e90,  1e91,  1e92,  1e93,  1e94,  1e95,  1e96,  1e97,  1e98,  1e99 };
+
+/* the powers of 10 of str2ld_r */
+inline constexpr long double pow10ld[] = { 1e-99L, 1e-98L, 1e-97L, 1e-96L, 1e-95L, 1e-94L, 1e-93L, 1e-92L, 1e-91L, 1e-90L,
+                                           1e-89L, 1e-88L, 1e-87L, 1e-86L, 1e-85L, 1e-84L, 1e-83L, 1e-82L, 1e-81L, 1e-80L,
+                                           1e-79L, 1e-78L, 1e-77L, 1e-76L, 1e-75L, 1e-74L, 1e-73L, 1e-72L, 1e-71L, 1e-70L,
+                                           1e-69L, 1e-68L, 1e-67L, 1e-66L, 1e-65L, 1e-64L, 1e-63L, 1e-62L, 1e-61L, 1e-60L,
+                                           1e-59L, 1e-58L, 1e-57L, 1e-56L, 1e-55L, 1e-54L, 1e-53L, 1e-52L, 1e-51L, 1e-50L,
+                                           1e-49L, 1e-48L, 1e-47L, 1e-46L, 1e-45L, 1e-44L, 1e-43L, 1e-42L, 1e-41L, 1e-40L,
+                                           1e-39L, 1e-38L, 1e-37L, 1e-36L, 1e-35L, 1e-34L, 1e-33L, 1e-32L, 1e-31L, 1e-30L,
+                                           1e-29L, 1e-28L, 1e-27L, 1e-26L, 1e-25L, 1e-24L, 1e-23L, 1e-22L, 1e-21L, 1e-20L,
+                                           1e-19L, 1e-18L, 1e-17L, 1e-16L, 1e-15L, 1e-14L, 1e-13L, 1e-12L, 1e-11L, 1e-10L,
+                                           1e-09L, 1e-08L, 1e-07L, 1e-06L, 1e-05L, 1e-04L, 1e-03L, 1e-02L, 1e-01L,
+                                            1e00L,  1e01L,  1e02L,  1e03L,  1e04L,  1e05L,  1e06L,  1e07L,  1e08L,  1e09L,
+                                            1e10L,  1e11L,  1e12L,  1e13L,  1e14L,  1e15L,  1e16L,  1e17L,  1e18L,  1e19L,
+                                            1e20L,  1e21L,  1e22L,  1e23L,  1e24L,  1e25L,  1e26L,  1e27L,  1e28L,  1e29L,
+                                            1e30L,  1e31L,  1e32L,  1e33L,  1e34L,  1e35L,  1e36L,  1e37L,  1e38L,  1e39L,
+                                            1e40L,  1e41L,  1e42L,  1e43L,  1e44L,  1e45L,  1e46L,  1e47L,  1e48L,  1e49L,
+                                            1e50L,  1e51L,  1e52L,  1e53L,  1e54L,  1e55L,  1e56L,  1e57L,  1e58L,  1e59L,
+                                            1e60L,  1e61L,  1e62L,  1e63L,  1e64L,  1e65L,  1e66L,  1e67L,  1e68L,  1e69L,
+                                            1e70L,  1e71L,  1e72L,  1e73L,  1e74L,  1e75L,  1e76L,  1e77L,  1e78L,  1e79L,
+                                            1e80L,  1e81L,  1e82L,  1e83L,  1e84L,  1e85L,  1e86L,  1e87L,  1e88L,  1e89L,
+                                            1e90L,  1e91L,  1e92L,  1e93L,  1e94L,  1e95L,  1e96L,  1e97L,  1e98L,  1e99L };
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   powi calculates a power of the base like powi and powil of str2num.c.
+\* ------------------------------------------------------------------------- */
+
+template <typename F>
+constexpr F powi(unsigned base, uint32_t expo)
+{
+   F val = F(1.0);
+
+   if(expo)
+   {
+      uint64_t v = 1;
+      uint64_t p = base;
+
+      if(expo & 1)
+         v = p;
+
+      while(expo >>= 1)
+      {
+         p *= p;
+
+         if(p > 0xffffffff)
+         {
+            F fp = (F) p;
+
+            if(expo & 1)
+               val = fp * v;
+            else
+               val = (F) v;
+
+            while(expo >>= 1)
+            {
+               fp *= fp;
+
+               if(expo & 1)
+                  val *= fp;
+            }
+            return (val);
+         }
+
+         if(expo & 1)
+            v *= p;
+      }
+
+      val = (F) v;
+   }
+
+   return (val);
+} /* F powi(unsigned base, uint32_t expo) */
+
+
+/* ------------------------------------------------------------------------- *\
+   mantissa adds a digit to the mantissa of a floating point value like
+   str2d_r (WIDE is false) or like str2ld_r (WIDE is true) which uses m1 for
+   the higher bits. It returns false if the digit exceeds the mantissa.
+\* ------------------------------------------------------------------------- */
+
+template <bool WIDE>
+S2N_FORCE_INLINE constexpr bool mantissa(uint64_t & m0, uint64_t & m1, unsigned base, unsigned d)
+{
+   if constexpr (WIDE)
+   {
+      if(m1 >= 0x400000000000000ull)
+         return (false);
+
+      m0 *= base;
+      m1 *= base;
+      m0 += d;
+      m1 += m0 >> 58;
+      m0 &= 0x3ffffffffffffffull;
+   }
+   else
+   {
+      if(m0 >= 0x400000000000000ull)
+         return (false);
+
+      m0 *= base;
+      m0 += d;
+   }
+
+   return (true);
+} /* bool mantissa(uint64_t & m0, uint64_t & m1, unsigned base, unsigned d) */
+
+
+/* ------------------------------------------------------------------------- *\
+   exponent reads the exponent of the base eb behind the character ps[0] and
+   its sign. ps is left unchanged if there is no valid exponent.
+\* ------------------------------------------------------------------------- */
+
+constexpr int32_t exponent(const char *& ps, const char * pend, unsigned eb)
+{
+   int32_t  e        = 0;
+   int32_t  exp_sign = 0; /* whether the exponent is signed */
+   unsigned d        = digit(ps, pend, 1);
+
+   if(d < eb)
+   {
+      e   = (int32_t) d;
+      ps += 2;
+   }
+   else if((at(ps, pend, 1) == '+') && ((d = digit(ps, pend, 2)) < eb))
+   {
+      e   = (int32_t) d;
+      ps += 3;
+   }
+   else if((at(ps, pend, 1) == '-') && ((d = digit(ps, pend, 2)) < eb))
+   {
+      exp_sign = 1;
+      e   = (int32_t) d;
+      ps += 3;
+   }
+
+   d = digit(ps, pend, 0);
+   while(d < eb)
+   {
+      if(e < 0x1000000)
+      { /* larger exponents overflow or underflow anyway */
+         e *= (int32_t) eb;
+         e += (int32_t) d;
+      }
+      d = digit(++ps, pend, 0);
+   }
+
+   return (exp_sign ? -e : e);
+} /* int32_t exponent(const char *& ps, const char * pend, unsigned eb) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2flt converts a range to a double like str2d_r or to a long double like
+   str2ld_r. It returns the error value and leaves ps behind the converted
+   characters.
+\* ------------------------------------------------------------------------- */
+
+template <typename F>
+constexpr int str2flt(const char *& ps, const char * pend, int base, F & ret)
+{
+   constexpr bool WIDE = std::is_same<F, long double>::value;
+   uint64_t       m0   = 0;   /* mantissa or lower bits of the mantissa */
+   uint64_t       m1   = 0;   /* higher bits of the mantissa of long doubles */
+   int32_t        sign = 0;   /* sign of the value */
+   int32_t        e    = 0;   /* value of exponent */
+   int32_t        c    = 0;   /* correction of comma position */
+   unsigned       d    = 0;   /* last found digit */
+   F              m    = F(0);
+   char           ch   = '\0';
+
+   if((base < 0) || (base > 36))
+      return (EINVAL);
+
+   /* skip leading blanks */
+   while((ps < pend) && ((*ps == ' ') || ((*ps >= 0x9) && (*ps <= 0xd))))
+      ++ps;
+
+   if(at(ps, pend, 0) == '-')
+   {
+      sign = -1;
+      ++ps;
+   }
+   else if(at(ps, pend, 0) == '+')
+   {
+      sign = 1;
+      ++ps;
+   }
+
+   if(((at(ps, pend, 0) | 0x20) == 'i') && ((at(ps, pend, 1) | 0x20) == 'n') && ((at(ps, pend, 2) | 0x20) == 'f'))
+   { /* "INF" found */
+      if(((at(ps, pend, 3) | 0x20) == 'i') && ((at(ps, pend, 4) | 0x20) == 'n') && ((at(ps, pend, 5) | 0x20) == 'i') &&
+         ((at(ps, pend, 6) | 0x20) == 't') && ((at(ps, pend, 7) | 0x20) == 'y') &&
+         ((base <= 34) || ((digit(ps, pend, 8) >= (unsigned) base) && (at(ps, pend, 8) != '.') && (at(ps, pend, 8) != '~'))))
+      {
+         ps += 8;
+         ret = (sign >= 0) ? std::numeric_limits<F>::infinity() : -std::numeric_limits<F>::infinity();
+         return (0);
+      }
+
+      if((base <= 23) || ((digit(ps, pend, 3) >= (unsigned) base) && (at(ps, pend, 3) != '.') && (at(ps, pend, 3) != '~')))
+      {
+         ps += 3;
+         ret = (sign >= 0) ? std::numeric_limits<F>::infinity() : -std::numeric_limits<F>::infinity();
+         return (0);
+      }
+   }
+   else if(((at(ps, pend, 0) | 0x20) == 'n') && ((at(ps, pend, 1) | 0x20) == 'a') && ((at(ps, pend, 2) | 0x20) == 'n'))
+   { /* "NAN" found */
+      if((base <= 23) || ((digit(ps, pend, 3) >= (unsigned) base) && (at(ps, pend, 3) != '.') && (at(ps, pend, 3) != '~')))
+      {
+         ps += 3;
+         ret = (sign >= 0) ? std::numeric_limits<F>::quiet_NaN() : -std::numeric_limits<F>::quiet_NaN();
+         return (0);
+      }
+   }
+
+   if(base < 2)
+   { /* let's detect the base */
+      base = 10; /* default base is 10 */
+
+      if(at(ps, pend, 0) == '0')
+      {
+         if(((at(ps, pend, 1) | 0x20) == 'x') && (digit(ps, pend, 2) < 16))
+         {
+            base = 16;
+            ps += 2;
+         }
+         else if(((at(ps, pend, 1) | 0x20) == 'b') && (digit(ps, pend, 2) < 2))
+         {
+            base = 2;
+            ps += 2;
+         }
+         else if(((at(ps, pend, 1) | 0x20) == 'o') && (digit(ps, pend, 2) < 8))
+         {
+            base = 8;
+            ps += 2;
+         }
+      }
+   }
+   else if(at(ps, pend, 0) == '0')
+   {
+      /* Care about base specifications in hex data even if base is given.
+         (It's a rather dirty thing within the specification of strtoul.) */
+      if((base == 16) && ((at(ps, pend, 1) | 0x20) == 'x') && (digit(ps, pend, 2) < 16))
+         ps += 2;
+      else if((base == 2) && ((at(ps, pend, 1) | 0x20) == 'b') && (digit(ps, pend, 2) < 2))
+         ps += 2;
+      else if((base == 8) && ((at(ps, pend, 1) | 0x20) == 'o') && (digit(ps, pend, 2) < 8))
+         ps += 2;
+   }
+
+   if(digit(ps, pend, 0) >= (unsigned) base)
+      return (EINVAL); /* not a valid number */
+
+   while(at(ps, pend, 0) == '0')
+      ++ps; /* skip leading zeros */
+
+   d = digit(ps, pend, 0);
+   if(d < (unsigned) base)
+   {
+      m0 = d;
+      d  = digit(++ps, pend, 0);
+
+      if constexpr (WIDE)
+      {
+         while((d < (unsigned) base) && (m0 < 0x20000000000000ull))
+         { /* m0 won't yet overflow */
+            m0 *= (unsigned) base;
+            m0 += d;
+            d = digit(++ps, pend, 0);
+         }
+      }
+
+      while(d < (unsigned) base)
+      {
+         if(!mantissa<WIDE>(m0, m1, (unsigned) base, d))
+            ++c;
+
+         d = digit(++ps, pend, 0);
+      }
+   }
+
+   if(at(ps, pend, 0) == '.')
+   {
+      d = digit(++ps, pend, 0);
+
+      if constexpr (WIDE)
+      {
+         while((d < (unsigned) base) && !m1 && (m0 < 0x20000000000000ull))
+         { /* m0 won't yet overflow and m1 isn't used yet */
+            m0 *= (unsigned) base;
+            m0 += d;
+            d = digit(++ps, pend, 0);
+            --c;
+         }
+      }
+
+      while(d < (unsigned) base)
+      {
+         if(mantissa<WIDE>(m0, m1, (unsigned) base, d))
+            --c;
+
+         d = digit(++ps, pend, 0);
+      }
+   }
+
+   ch = at(ps, pend, 0);
+   if(((base < 15) && ((ch | 0x20) == 'e')) || (ch == '~'))
+   {
+      e = exponent(ps, pend, (unsigned) base);
+   }
+   else if((base == 16) && ((ch | 0x20) == 'p'))
+   {  /* Seems to be a printf %a of %A output string that uses a decimal printed binary exponent ... */
+      e     = exponent(ps, pend, 10);
+      base  = 2;
+      c    *= 4;
+   }
+
+   e += c;
+
+   if constexpr (WIDE)
+      m = (F) m1 * 0x400000000000000ll + m0;
+   else
+      m = (F) m0;
+
+   if(!m0 && !m1)
+      ret = F(0.0); /* prevent 0 * inf in case of huge exponents */
+   else
+#if S2N_USE_POW10_ARRAY
+   if((base == 10) && (e < 100) && (e > -100))
+   {
+      if constexpr (WIDE)
+         ret = m * pow10ld[e + 99];
+      else
+         ret = m * pow10d[e + 99];
+   }
+   else
+#endif
+   if(e >= 0)
+   {
+      ret = m * powi<F>((unsigned) base, (uint32_t) e);
+   }
+   else if(WIDE && (e >= -192))
+   {
+      ret = m / powi<F>((unsigned) base, (uint32_t) -e);
+   }
+   else
+   {  /* Try to prevent a possible overflow within powi */
+      F p = F(0.0);
+      c   = e / 2;
+      e  -= c;
+      p   = powi<F>((unsigned) base, (uint32_t) -c);
+
+      ret = m / p;
+
+      if(e != c)
+         p *= base;
+
+      ret /= p;
+   }
+
+   if(sign < 0)
+      ret = -ret;
+
+   return (0);
+} /* int str2flt(const char *& ps, const char * pend, int base, F & ret) */
+
+} /* namespace detail */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2int_r converts a range to an integer of the type T.
+\* ------------------------------------------------------------------------- */
+
+template <typename T, int BASE = 0>
+S2N_FORCE_INLINE constexpr T str2int_r(const char * ps, const char * pend, const char ** ppe, int base, int * perr)
+{
+   static_assert((BASE == 0) || ((BASE >= 2) && (BASE <= 36)), "BASE must be 0 or 2 - 36");
+   static_assert(std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value,
+                 "s2n::str2int_r requires an integer type");
+
+   const char * pe  = ps;
+   T            ret = T(0);
+   int          err = EINVAL;
+
+   if(ps)
+   {
+      if constexpr (std::numeric_limits<T>::is_signed)
+         err = detail::str2sint<T, BASE>(pe, pend, base, ret);
+      else
+         err = detail::str2uint<T, BASE>(pe, pend, base, ret);
+
+      if(err == EINVAL)
+         pe = ps;
+   }
+
+   if(perr)
+      *perr = err;
+
+   if(ppe)
+      *ppe = pe;
+
+   return (ret);
+} /* T str2int_r(const char * ps, const char * pend, const char ** ppe, int base, int * perr) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2flt_r converts a range to a floating point value of the type T.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+constexpr T str2flt_r(const char * ps, const char * pend, const char ** ppe, int base, int * perr)
+{
+   static_assert(std::is_floating_point<T>::value, "s2n::str2flt_r requires a floating point type");
+
+   /* float is converted like str2f by the double function */
+   using F = typename std::conditional<std::is_same<T, long double>::value, long double, double>::type;
+
+   const char * pe  = ps;
+   F            ret = F(0.0);
+   int          err = EINVAL;
+
+   if(ps)
+   {
+      err = detail::str2flt<F>(pe, pend, base, ret);
+      if(err)
+         pe = ps;
+   }
+
+   if(perr)
+      *perr = err;
+
+   if(ppe)
+      *ppe = pe;
+
+   return ((T) ret);
+} /* T str2flt_r(const char * ps, const char * pend, const char ** ppe, int base, int * perr) */
+
+
+/* ------------------------------------------------------------------------- *\
+   from_chars converts a range of characters to an integer or floating point
+   value of the type T.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+constexpr from_chars_result from_chars(const char * first, const char * last, T & value, int base = 10)
+{
+   static_assert((std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value) || std::is_floating_point<T>::value,
+                 "s2n::from_chars supports integer and floating point types only");
+
+   const char * pe  = first;
+   int          err = 0;
+   T            v   = T(0);
+
+   if constexpr (std::is_floating_point<T>::value)
+      v = str2flt_r<T>(first, last, &pe, base, &err);
+   else
+      v = str2int_r<T>(first, last, &pe, base, &err);
+
+   if(!err)
+      value = v;
+
+   return (from_chars_result { pe, detail::errc(err) });
+} /* from_chars_result from_chars(const char * first, const char * last, T & value, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   from_chars converts a range of characters to an integer of the fixed
+   numeric base BASE.
+\* ------------------------------------------------------------------------- */
+
+template <int BASE, typename T>
+constexpr from_chars_result from_chars(const char * first, const char * last, T & value)
+{
+   const char * pe  = first;
+   int          err = 0;
+   T            v   = str2int_r<T, BASE>(first, last, &pe, BASE, &err);
+
+   if(!err)
+      value = v;
+
+   return (from_chars_result { pe, detail::errc(err) });
+} /* from_chars_result from_chars<BASE>(const char * first, const char * last, T & value) */
+
+
+/* ------------------------------------------------------------------------- *\
+   from_chars converts the characters of a string_view.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+constexpr from_chars_result from_chars(std::string_view sv, T & value, int base = 10)
+{
+   return (from_chars(sv.data(), sv.data() + sv.size(), value, base));
+} /* from_chars_result from_chars(std::string_view sv, T & value, int base) */
+
+
+namespace detail
+{
+
+/* ------------------------------------------------------------------------- *\
+   field converts a field of a delimited buffer with leading and trailing
+   blanks and returns 0 or the error value of the conversion. value is set
+   to 0 if the field doesn't contain a single valid number.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+constexpr int field(const char * ps, const char * pend, int base, T & value)
+{
+   const char * pe  = ps;
+   int          err = 0;
+
+   if constexpr (std::is_floating_point<T>::value)
+      value = str2flt_r<T>(ps, pend, &pe, base, &err);
+   else
+      value = str2int_r<T>(ps, pend, &pe, base, &err);
+
+   while((pe < pend) && ((*pe == ' ') || ((*pe >= 0x9) && (*pe <= 0xd))))
+      ++pe;
+
+   if(!err && (pe != pend))
+      err = EINVAL; /* the field contains more than a number */
+
+   if(err == EINVAL)
+      value = T(0);
+
+   return (err);
+} /* int field(const char * ps, const char * pend, int base, T & value) */
+
+} /* namespace detail */
+
+
+#if defined (__cpp_lib_ranges)
+
+/* ------------------------------------------------------------------------- *\
+   numbers is a view of the delimited numbers of a buffer.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+class numbers : public std::ranges::view_interface<numbers<T>>
+{
+   static_assert((std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value) || std::is_floating_point<T>::value,
+                 "s2n::numbers supports integer and floating point types only");
+
+public:
+   class iterator
+   {
+   public:
+      using iterator_concept  = std::forward_iterator_tag;
+      using iterator_category = std::input_iterator_tag; /* operator * returns the value */
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+
+      constexpr iterator() = default;
+
+      constexpr T operator * () const { return (value); }
+
+      constexpr iterator & operator ++ ()
+      {
+         next();
+         return (*this);
+      }
+
+      constexpr iterator operator ++ (int)
+      {
+         iterator it = *this;
+         next();
+         return (it);
+      }
+
+      /* error of the conversion of the current field */
+      constexpr std::errc error() const { return (ec); }
+
+      /* characters of the current field */
+      constexpr std::string_view text() const { return (std::string_view(ps, (size_t) (pe - ps))); }
+
+      friend constexpr bool operator == (const iterator & a, const iterator & b) { return (a.ps == b.ps); }
+      friend constexpr bool operator == (const iterator & it, std::default_sentinel_t) { return (!it.ps); }
+
+   private:
+      friend class numbers;
+
+      const char * ps     = nullptr; /* current field or nullptr at the end */
+      const char * pe     = nullptr; /* end of the current field */
+      const char * pend   = nullptr; /* end of the buffer */
+      const char * pdelim = nullptr; /* delimiter */
+      size_t       dlen   = 0;       /* length of the delimiter */
+      int          base   = 10;      /* numeric base */
+      std::errc    ec     = std::errc();
+      T            value  = T(0);
+
+      constexpr iterator(const char * pbuf, size_t len, std::string_view delim, int b) :
+         ps(pbuf), pend(pbuf + len), pdelim(delim.data()), dlen(delim.size()), base(b)
+      {
+         if(len)
+            field();
+         else
+            ps = nullptr;
+      }
+
+      /* field finds the end of the field at ps and converts it */
+      constexpr void field()
+      {
+         pe = nullptr;
+
+         if(dlen == 1)
+         {
+            pe = std::char_traits<char>::find(ps, (size_t) (pend - ps), *pdelim);
+         }
+         else if(dlen)
+         {
+            size_t pos = std::string_view(ps, (size_t) (pend - ps)).find(std::string_view(pdelim, dlen));
+
+            if(pos != std::string_view::npos)
+               pe = ps + pos;
+         }
+
+         if(!pe)
+            pe = pend; /* the last field */
+
+         ec = detail::errc(detail::field<T>(ps, pe, base, value));
+      }
+
+      constexpr void next()
+      {
+         if((size_t) (pend - pe) <= dlen)
+         {
+            ps = nullptr; /* no further field behind the last delimiter */
+            pe = nullptr;
+            return;
+         }
+
+         ps = pe + dlen;
+         field();
+      }
+   };
+
+   constexpr numbers() = default;
+
+   constexpr numbers(std::string_view buf, std::string_view delim = ",", int base = 10) :
+      sv(buf), dl(delim), b(base)
+   {}
+
+   constexpr iterator begin() const { return (iterator(sv.data(), sv.size(), dl, b)); }
+
+   constexpr std::default_sentinel_t end() const { return (std::default_sentinel); }
+
+private:
+   std::string_view sv;     /* buffer */
+   std::string_view dl;     /* delimiter */
+   int              b = 10; /* numeric base */
+}; /* class numbers */
+
+#endif /* __cpp_lib_ranges */
+
+
+namespace detail
+{
+
+/* ------------------------------------------------------------------------- *\
+   literal_error converts the characters of a user defined literal of the
+   numeric base BASE into *pv and returns 0, EINVAL or ERANGE. A literal may
+   contain digits of its base only and no blanks, signs or prefixes, because
+   "-1"_b10 would be UINT64_MAX otherwise.
+\* ------------------------------------------------------------------------- */
+
+template <int BASE>
+constexpr int literal_error(const char * ps, size_t len, unsigned long long * pv)
+{
+   const char * pe  = ps;
+   int          err = len ? 0 : EINVAL;
+
+   *pv = 0;
+
+   for(size_t i = 0; !err && (i < len); ++i)
+   {
+      if(digit_table[(uint8_t) ps[i]] >= (unsigned) BASE)
+         err = EINVAL;
+   }
+
+   if(!err)
+   {
+      *pv = str2int_r<unsigned long long, BASE>(ps, ps + len, &pe, BASE, &err);
+
+      if(!err && (pe != ps + len))
+         err = EINVAL;
+   }
+
+   return (err);
+} /* int literal_error(const char * ps, size_t len, unsigned long long * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   literal converts the characters of a user defined literal of the numeric
+   base BASE. The throw expressions aren't allowed in constant expressions
+   and make invalid literals fail at compile time.
+\* ------------------------------------------------------------------------- */
+
+template <int BASE>
+constexpr unsigned long long literal(const char * ps, size_t len)
+{
+   unsigned long long ret = 0;
+   int                err = literal_error<BASE>(ps, len, &ret);
+
+   if(err == ERANGE)
+      throw std::out_of_range("s2n literal exceeds unsigned long long");
+
+   if(err)
+      throw std::invalid_argument("s2n literal isn't a valid number");
+
+   return (ret);
+} /* unsigned long long literal(const char * ps, size_t len) */
+
+} /* namespace detail */
+
+
+namespace literals
+{
+
+#define S2N_LITERAL(b) \
+constexpr unsigned long long operator""_b##b (const char * ps, size_t len) { return (detail::literal<b>(ps, len)); }
+
+S2N_LITERAL(2)  S2N_LITERAL(3)  S2N_LITERAL(4)  S2N_LITERAL(5)  S2N_LITERAL(6)  S2N_LITERAL(7)  S2N_LITERAL(8)
+S2N_LITERAL(9)  S2N_LITERAL(10) S2N_LITERAL(11) S2N_LITERAL(12) S2N_LITERAL(13) S2N_LITERAL(14) S2N_LITERAL(15)
+S2N_LITERAL(16) S2N_LITERAL(17) S2N_LITERAL(18) S2N_LITERAL(19) S2N_LITERAL(20) S2N_LITERAL(21) S2N_LITERAL(22)
+S2N_LITERAL(23) S2N_LITERAL(24) S2N_LITERAL(25) S2N_LITERAL(26) S2N_LITERAL(27) S2N_LITERAL(28) S2N_LITERAL(29)
+S2N_LITERAL(30) S2N_LITERAL(31) S2N_LITERAL(32) S2N_LITERAL(33) S2N_LITERAL(34) S2N_LITERAL(35) S2N_LITERAL(36)
+
+#undef S2N_LITERAL
+
+} /* namespace literals */
+
+} /* namespace s2n */
+
+#if defined (__cpp_lib_ranges)
+/* The iterators of s2n::numbers point into the buffer and stay valid without the view. */
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<s2n::numbers<T>> = true;
+#endif
+
+#endif /* STR2NUM_HPP */
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -0,0 +1,1386 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num_batch.c                                              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : conversion functions for buffers of delimited numbers        *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#ifndef STR2NUM_BATCH_C
+#define STR2NUM_BATCH_C
+
+#include <errno.h>
+#include <math.h>   /* HUGE_VAL */
+#include <stdlib.h> /* malloc */
+#include <string.h> /* memchr */
+
+#if defined (_WIN32)
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <str2num_batch.h>
+
+/* size of the local buffer for copies of fields at the end of a buffer */
+#define FIELD_BUF_SIZE 128
+
+#define IS_BLANK(c) (((c) == ' ') || (((c) >= 0x9) && ((c) <= 0xd)))
+
+#if S2N_USDT
+#include <sys/sdt.h>
+
+/* static tracepoints str2num:batch_begin (buffer, length, delimiter) and
+   str2num:batch_end (end of the buffer, rows, errors) */
+#define PROBE3(name, a, b, c) DTRACE_PROBE3(str2num, name, a, b, c)
+#else
+#define PROBE3(name, a, b, c) ((void) 0)
+#endif
+
+
+/* ========================================================================= *\
+   Helper functions
+\* ========================================================================= */
+
+typedef struct FIELD_S FIELD;
+struct FIELD_S
+{
+   const char * ps;   /* first non blank character of the field */
+   size_t       len;  /* length of the field without leading and trailing blanks */
+   int          term; /* nonzero if another character of the buffer follows the field */
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   number_char returns nonzero if a character may be part of a number.
+\* ------------------------------------------------------------------------- */
+
+static int number_char(char c)
+{
+   return ((digit_value[(uint8_t) c] < 64) || (c == '+') || (c == '-') || (c == '.') || (c == '~'));
+} /* int number_char(char c) */
+
+
+/* ------------------------------------------------------------------------- *\
+   valid_args checks the common arguments of the buffer functions.
+\* ------------------------------------------------------------------------- */
+
+static int valid_args(const char * ps, char delim, int base)
+{
+   if(!ps || (base < 0) || (base > 36))
+      return (0);
+
+   /* The parsers must never read beyond the delimiter of a field. */
+   if(number_char(delim))
+      return (0);
+
+   return (1);
+} /* int valid_args(const char * ps, char delim, int base) */
+
+
+/* ------------------------------------------------------------------------- *\
+   next_field stores the position of the next field in *pf and returns the
+   position of the field after it.
+\* ------------------------------------------------------------------------- */
+
+static const char * next_field(const char * ps, const char * pend, char delim, FIELD * pf)
+{
+   const char * pd    = (const char *) memchr(ps, delim, (size_t) (pend - ps));
+   const char * pe    = pd ? pd : pend;
+   const char * pnext = pd ? pd + 1 : pend;
+
+   while((ps < pe) && IS_BLANK(*ps))
+      ++ps;
+
+   while((pe > ps) && IS_BLANK(pe[-1]))
+      --pe;
+
+   pf->ps   = ps;
+   pf->len  = (size_t) (pe - ps);
+   pf->term = (pe < pend);
+
+   return (pnext);
+} /* const char * next_field(const char * ps, const char * pend, char delim, FIELD * pf) */
+
+
+/* ------------------------------------------------------------------------- *\
+   field_text returns a pointer to the text of a field that is terminated by
+   a character that can't be part of the number. Fields at the very end of
+   the buffer are copied into pbuf or into a heap buffer that is returned in
+   *ppheap and must be released by the caller.
+\* ------------------------------------------------------------------------- */
+
+static const char * field_text(const FIELD * pf, char * pbuf, size_t size, char ** ppheap)
+{
+   char * pcopy = pbuf;
+
+   if(pf->term)
+      return (pf->ps); /* the character after the field ends the number */
+
+   if(pf->len >= size)
+   {
+      pcopy = (char *) malloc(pf->len + 1);
+      *ppheap = pcopy;
+      if(!pcopy)
+         return (NULL);
+   }
+
+   memcpy(pcopy, pf->ps, pf->len);
+   pcopy[pf->len] = '\0';
+
+   return (pcopy);
+} /* const char * field_text(const FIELD * pf, char * pbuf, size_t size, char ** ppheap) */
+
+
+/* ------------------------------------------------------------------------- *\
+   field_filter copies the text of a field without the group separators into
+   pbuf or into a heap buffer like field_text and replaces the decimal
+   separator by a '.'. Other points end the number if the decimal separator
+   is a different character. The length of the copy is stored in *plen.
+\* ------------------------------------------------------------------------- */
+
+static const char * field_filter(const FIELD * pf, char group, char decimal, char * pbuf, size_t size, char ** ppheap, size_t * plen)
+{
+   const char * ps    = pf->ps;
+   const char * pend  = ps + pf->len;
+   char *       pcopy = pbuf;
+   char *       pd;
+
+   if(pf->len >= size)
+   {
+      pcopy = (char *) malloc(pf->len + 1);
+      *ppheap = pcopy;
+      if(!pcopy)
+         return (NULL);
+   }
+
+   pd = pcopy;
+
+   while(ps < pend)
+   {
+      char c = *ps++;
+
+      if(c == group)
+         continue;
+
+      if(c == decimal)
+         c = '.';
+      else if(c == '.')
+         c = '\0';
+
+      *pd++ = c;
+   }
+
+   *pd   = '\0';
+   *plen = (size_t) (pd - pcopy);
+
+   return (pcopy);
+} /* const char * field_filter(...) */
+
+
+/* ========================================================================= *\
+   Parallel processing of buffers
+\* ========================================================================= */
+
+typedef int (* BATCH_FN) (const char * ps, size_t len, char delim, int base, void * pres);
+
+typedef struct BATCH_JOB_S BATCH_JOB;
+struct BATCH_JOB_S
+{
+   BATCH_FN     fn;    /* function that processes the part of the buffer */
+   const char * ps;    /* start of the part */
+   size_t       len;   /* length of the part */
+   char         delim; /* delimiter of the fields */
+   int          base;  /* numeric base */
+   void *       pres;  /* result of the part */
+   int          err;   /* return value of fn */
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   batch_threads returns the number of threads for a buffer of len bytes.
+\* ------------------------------------------------------------------------- */
+
+static int batch_threads(size_t len, int threads)
+{
+   size_t max = len / S2N_MT_MIN_CHUNK + 1;
+
+   if(threads <= 0)
+   {
+#if defined (_WIN32)
+      SYSTEM_INFO si;
+      GetSystemInfo(&si);
+      threads = (int) si.dwNumberOfProcessors;
+#elif defined (_SC_NPROCESSORS_ONLN)
+      threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+      if(threads <= 0)
+         threads = 1;
+   }
+
+   if((size_t) threads > max)
+      threads = (int) max;
+
+   return (threads);
+} /* int batch_threads(size_t len, int threads) */
+
+
+#if defined (_WIN32)
+static unsigned __stdcall batch_thread(void * pv)
+{
+   BATCH_JOB * pj = (BATCH_JOB *) pv;
+   pj->err = pj->fn(pj->ps, pj->len, pj->delim, pj->base, pj->pres);
+   return (0);
+} /* unsigned __stdcall batch_thread(void * pv) */
+#else
+static void * batch_thread(void * pv)
+{
+   BATCH_JOB * pj = (BATCH_JOB *) pv;
+   pj->err = pj->fn(pj->ps, pj->len, pj->delim, pj->base, pj->pres);
+   return (NULL);
+} /* void * batch_thread(void * pv) */
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   run_parallel splits the buffer at delimiters into threads parts and calls
+   fn for each of them. The results of the parts are stored in pres that must
+   provide space for threads results of res_size bytes.
+\* ------------------------------------------------------------------------- */
+
+static int run_parallel(const char * ps, size_t len, char delim, int base, int threads,
+                        BATCH_FN fn, void * pres, size_t res_size)
+{
+   int          err    = ENOMEM;
+   const char * pend   = ps + len;
+   const char * pstart = ps;
+   BATCH_JOB *  pjob   = (BATCH_JOB *) malloc(threads * sizeof(BATCH_JOB));
+#if defined (_WIN32)
+   HANDLE *     pth    = (HANDLE *) malloc(threads * sizeof(HANDLE));
+#else
+   pthread_t *  pth    = (pthread_t *) malloc(threads * sizeof(pthread_t));
+#endif
+   char *       prun   = (char *) malloc(threads);
+   int          i;
+
+   if(!pjob || !pth || !prun || (threads < 1))
+      goto Exit;
+
+   for(i = 0; i < threads; ++i)
+   { /* split the buffer after the first delimiter behind the nominal start of the next part */
+      const char * pnext = pend;
+
+      if(i + 1 < threads)
+      {
+         const char * pd;
+         size_t       pos = len / threads * (i + 1);
+
+         pnext = pos ? ps + pos - 1 : ps;
+
+         if(pnext < pstart)
+            pnext = pstart;
+
+         pd    = (const char *) memchr(pnext, delim, (size_t) (pend - pnext));
+         pnext = pd ? pd + 1 : pend;
+      }
+
+      pjob[i].fn    = fn;
+      pjob[i].ps    = pstart;
+      pjob[i].len   = (size_t) (pnext - pstart);
+      pjob[i].delim = delim;
+      pjob[i].base  = base;
+      pjob[i].pres  = (char *) pres + i * res_size;
+      pjob[i].err   = 0;
+      prun[i]       = 0;
+
+      pstart = pnext;
+   }
+
+   for(i = 1; i < threads; ++i)
+   {
+#if defined (_WIN32)
+      pth[i] = (HANDLE) _beginthreadex(NULL, 0, batch_thread, pjob + i, 0, NULL);
+      if(pth[i])
+         prun[i] = 1;
+#else
+      if(!pthread_create(pth + i, NULL, batch_thread, pjob + i))
+         prun[i] = 1;
+#endif
+      else
+         batch_thread(pjob + i); /* do the work ourselves if there are no threads left */
+   }
+
+   batch_thread(pjob);
+
+   err = 0;
+
+   for(i = 0; i < threads; ++i)
+   {
+      if(prun[i])
+      {
+#if defined (_WIN32)
+         WaitForSingleObject(pth[i], INFINITE);
+         CloseHandle(pth[i]);
+#else
+         pthread_join(pth[i], NULL);
+#endif
+      }
+
+      if(pjob[i].err && !err)
+         err = pjob[i].err;
+   }
+
+Exit:;
+
+   if(pjob)
+      free(pjob);
+
+   if(pth)
+      free(pth);
+
+   if(prun)
+      free(prun);
+
+   return (err);
+} /* int run_parallel(...) */
+
+
+/* ========================================================================= *\
+   Selection helpers
+\* ========================================================================= */
+
+/* powers of 10 for the range checks of decimal integers by their number of digits */
+static const uint64_t pow10u[20] = { 1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+                                     100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+                                     10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+                                     100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull };
+
+
+/* ------------------------------------------------------------------------- *\
+   str2rows returns the number of rows (fields) of a buffer.
+\* ------------------------------------------------------------------------- */
+
+size_t str2rows(const char * ps, size_t len, char delim)
+{
+   const char * pend = ps + len;
+   size_t       rows = 0;
+
+   if(!ps || !len)
+      return (0);
+
+   while(ps < pend)
+   {
+      const char * pd = (const char *) memchr(ps, delim, (size_t) (pend - ps));
+      if(!pd)
+         break;
+      ps = pd + 1;
+      ++rows;
+   }
+
+   if(ps < pend)
+      ++rows; /* last row without a trailing delimiter */
+
+   return (rows);
+} /* size_t str2rows(const char * ps, size_t len, char delim) */
+
+
+/* ------------------------------------------------------------------------- *\
+   dec_digits returns the number of significant digits of a field that is a
+   plain decimal integer or -1 for anything else. *pneg is set to nonzero if
+   the number is negative.
+\* ------------------------------------------------------------------------- */
+
+static int dec_digits(const FIELD * pf, int * pneg)
+{
+   const char * ps   = pf->ps;
+   const char * pend = ps + pf->len;
+   const char * pd;
+
+   *pneg = 0;
+
+   if((ps < pend) && ((*ps == '-') || (*ps == '+')))
+   {
+      *pneg = (*ps == '-');
+      ++ps;
+   }
+
+   if((ps == pend) || ((uint8_t) (*ps - '0') >= 10))
+      return (-1); /* not a number */
+
+   while((ps < pend) && (*ps == '0'))
+      ++ps; /* skip leading zeros */
+
+   pd = ps;
+   while((ps < pend) && ((uint8_t) (*ps - '0') < 10))
+      ++ps;
+
+   if((ps != pend) || ((pend - pd) > 20))
+      return (-1);
+
+   return ((int) (pend - pd));
+} /* int dec_digits(const FIELD * pf, int * pneg) */
+
+
+/* ------------------------------------------------------------------------- *\
+   early_i64 returns nonzero if a decimal field is a valid int64_t value out
+   of the range lo - hi because of its number of digits.
+\* ------------------------------------------------------------------------- */
+
+static int early_i64(const FIELD * pf, int64_t lo, int64_t hi)
+{
+   int     neg;
+   int     n = dec_digits(pf, &neg);
+   int64_t vmin;
+   int64_t vmax;
+
+   if((n < 0) || (n > 18))
+      return (0); /* convert it */
+
+   if(!n)
+      return ((lo > 0) || (hi < 0));
+
+   vmin = (int64_t) pow10u[n-1];
+   vmax = (int64_t) pow10u[n] - 1;
+
+   if(neg)
+      return ((-vmin < lo) || (-vmax > hi));
+
+   return ((vmax < lo) || (vmin > hi));
+} /* int early_i64(const FIELD * pf, int64_t lo, int64_t hi) */
+
+
+/* ------------------------------------------------------------------------- *\
+   early_u64 returns nonzero if a decimal field is a valid uint64_t value out
+   of the range lo - hi because of its number of digits.
+\* ------------------------------------------------------------------------- */
+
+static int early_u64(const FIELD * pf, uint64_t lo, uint64_t hi)
+{
+   int neg;
+   int n = dec_digits(pf, &neg);
+
+   if((n < 0) || (n > 19) || neg)
+      return (0); /* convert it */
+
+   if(!n)
+      return (lo > 0);
+
+   return (((pow10u[n] - 1) < lo) || (pow10u[n-1] > hi));
+} /* int early_u64(const FIELD * pf, uint64_t lo, uint64_t hi) */
+
+
+/* ========================================================================= *\
+   Column helpers
+\* ========================================================================= */
+
+const char * const s2n_null_tokens[] = { "", "NA", "null", "-", NULL };
+
+/* sizes of the values of the column types */
+static const uint8_t col_size[] = { 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+
+/* ------------------------------------------------------------------------- *\
+   alloc64 allocates a 64 byte aligned buffer that is released by free64.
+\* ------------------------------------------------------------------------- */
+
+static void * alloc64(size_t size)
+{
+   uint8_t * pm = (uint8_t *) malloc(size + 64 + sizeof(void *));
+   uint8_t * pa;
+
+   if(!pm)
+      return (NULL);
+
+   pa = (uint8_t *) (((uintptr_t) (pm + sizeof(void *)) + 63) & ~(uintptr_t) 63);
+   ((void **) pa)[-1] = pm; /* keep the pointer of malloc in front of the buffer */
+
+   return (pa);
+} /* void * alloc64(size_t size) */
+
+
+/* ------------------------------------------------------------------------- *\
+   free64 releases a buffer of alloc64.
+\* ------------------------------------------------------------------------- */
+
+static void free64(void * pa)
+{
+   if(pa)
+      free(((void **) pa)[-1]);
+} /* void free64(void * pa) */
+
+
+/* ------------------------------------------------------------------------- *\
+   is_null_token returns nonzero if a field matches one of the null tokens.
+\* ------------------------------------------------------------------------- */
+
+static int is_null_token(const FIELD * pf, const char * const * ppnull)
+{
+   while(*ppnull)
+   {
+      const char * pt = *ppnull++;
+
+      if(!strncmp(pt, pf->ps, pf->len) && !pt[pf->len])
+         return (1);
+   }
+
+   return (0);
+} /* int is_null_token(const FIELD * pf, const char * const * ppnull) */
+
+
+/* ========================================================================= *\
+   Typed buffer functions
+\* ========================================================================= */
+
+/*
+   AGG      name of function that calculates the aggregates
+   AGG_MT   name of the parallel function that calculates the aggregates
+   AGG_JOB  name of the job function of the parallel function
+   SEL      name of function that selects the rows of a range of values
+   EARLY    rejects decimal integers out of the range by their number of digits
+   AT       type of the aggregates
+   V_MIN    minimum of the values
+   V_MAX    maximum of the values
+   SUM_ADD  adds a value to the sum and updates the overflow flag
+   COL      name of the function that appends the values of a buffer to a column
+   VT       type of the values
+   PFN      name of the function that converts a field
+   PARSE    conversion function of str2num.c
+   CTX      name of the function that converts a field with a parser context
+   DEC      decimal separator of a parser context that is replaced by a '.'
+
+   The aggregate and selection functions are only generated if AGG is defined
+   and the parser context functions only if CTX is defined.
+*/
+
+#define AGG     str2agg_i64
+#define AGG_MT  str2agg_i64_mt
+#define AGG_JOB agg_job_i64
+#define SEL     str2sel_i64
+#define EARLY   early_i64
+#define AT      s2n_agg_i64
+#define V_MIN   INT64_MIN
+#define V_MAX   INT64_MAX
+#define SUM_ADD(sum, v, ovf) { int64_t s_ = (int64_t) ((uint64_t) (sum) + (uint64_t) (v)); \
+                               if(((sum ^ s_) & (v ^ s_)) < 0) ovf = 1;                    \
+                               sum = s_; }
+#define COL     col_i64
+#define VT      int64_t
+#define PFN     field_i64
+#define PARSE   str2i64_r
+#define CTX     s2n_ctx_i64
+#define DEC(pctx) '.'
+
+#include "str2num_batch.c"
+
+#define AGG     str2agg_u64
+#define AGG_MT  str2agg_u64_mt
+#define AGG_JOB agg_job_u64
+#define SEL     str2sel_u64
+#define EARLY   early_u64
+#define AT      s2n_agg_u64
+#define V_MIN   0
+#define V_MAX   UINT64_MAX
+#define SUM_ADD(sum, v, ovf) { uint64_t s_ = (sum) + (v); \
+                               if(s_ < (sum)) ovf = 1;    \
+                               sum = s_; }
+#define COL     col_u64
+#define VT      uint64_t
+#define PFN     field_u64
+#define PARSE   str2u64_r
+#define CTX     s2n_ctx_u64
+#define DEC(pctx) '.'
+
+#include "str2num_batch.c"
+
+#define AGG     str2agg_d
+#define AGG_MT  str2agg_d_mt
+#define AGG_JOB agg_job_d
+#define SEL     str2sel_d
+#define EARLY(pf, lo, hi) 0
+#define AT      s2n_agg_d
+#define V_MIN   (-HUGE_VAL)
+#define V_MAX   HUGE_VAL
+#define SUM_ADD(sum, v, ovf) { sum += (v); }
+#define COL     col_f64
+#define VT      double
+#define PFN     field_d
+#define PARSE   str2d_r
+#define CTX     s2n_ctx_d
+#define DEC(pctx) (pctx)->decimal
+
+#include "str2num_batch.c"
+
+#define COL     col_i32
+#define VT      int32_t
+#define PFN     field_i32
+#define PARSE   str2i32_r
+
+#include "str2num_batch.c"
+
+#define COL     col_u32
+#define VT      uint32_t
+#define PFN     field_u32
+#define PARSE   str2u32_r
+
+#include "str2num_batch.c"
+
+#define COL     col_i16
+#define VT      int16_t
+#define PFN     field_i16
+#define PARSE   str2i16_r
+
+#include "str2num_batch.c"
+
+#define COL     col_u16
+#define VT      uint16_t
+#define PFN     field_u16
+#define PARSE   str2u16_r
+
+#include "str2num_batch.c"
+
+#define COL     col_i8
+#define VT      int8_t
+#define PFN     field_i8
+#define PARSE   str2i8_r
+
+#include "str2num_batch.c"
+
+#define COL     col_u8
+#define VT      uint8_t
+#define PFN     field_u8
+#define PARSE   str2u8_r
+
+#include "str2num_batch.c"
+
+#define COL     col_f32
+#define VT      float
+#define PFN     field_f32
+#define PARSE   str2d_r
+
+#include "str2num_batch.c"
+
+
+/* ========================================================================= *\
+   Column functions
+\* ========================================================================= */
+
+typedef void (* COL_FN) (s2n_col * pcol, const char * ps, const char * pend, char delim);
+
+/* append functions of the column types */
+static const COL_FN col_fn[] = { NULL, col_i8, col_u8, col_i16, col_u16, col_i32, col_u32, col_i64, col_u64, col_f32, col_f64 };
+
+/* Arrow format strings of the column types */
+static const char * const col_format[] = { "", "c", "C", "s", "S", "i", "I", "l", "L", "f", "g" };
+
+
+/* ------------------------------------------------------------------------- *\
+   col_reserve makes sure that the buffers of a column can take another
+   count values.
+\* ------------------------------------------------------------------------- */
+
+static int col_reserve(s2n_col * pcol, size_t count)
+{
+   size_t    capacity = pcol->capacity;
+   size_t    vsize;
+   size_t    bsize;
+   void *    pvalues;
+   uint8_t * pvalidity;
+
+   if(pcol->length + count <= capacity)
+      return (0);
+
+   if(capacity < 64)
+      capacity = 64;
+
+   while(capacity < pcol->length + count)
+      capacity *= 2;
+
+   /* The buffers are padded to a multiple of 64 bytes as Arrow recommends. */
+   vsize     = (capacity * col_size[pcol->type] + 63) & ~(size_t) 63;
+   bsize     = (((capacity + 7) >> 3) + 63) & ~(size_t) 63;
+   pvalues   = alloc64(vsize);
+   pvalidity = (uint8_t *) alloc64(bsize);
+
+   if(!pvalues || !pvalidity)
+   {
+      free64(pvalues);
+      free64(pvalidity);
+      return (ENOMEM);
+   }
+
+   memset(pvalidity, 0, bsize);
+
+   if(pcol->length)
+   {
+      memcpy(pvalues, pcol->pvalues, pcol->length * col_size[pcol->type]);
+      memcpy(pvalidity, pcol->pvalidity, (pcol->length + 7) >> 3);
+   }
+
+   free64(pcol->pvalues);
+   free64(pcol->pvalidity);
+
+   pcol->pvalues   = pvalues;
+   pcol->pvalidity = pvalidity;
+   pcol->capacity  = capacity;
+
+   return (0);
+} /* int col_reserve(s2n_col * pcol, size_t count) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2col_init initializes an empty column.
+\* ------------------------------------------------------------------------- */
+
+int str2col_init(s2n_col * pcol, int type, int base, size_t capacity, const char * const * ppnull)
+{
+   if(!pcol)
+      return (EINVAL);
+
+   memset(pcol, 0, sizeof(*pcol));
+
+   if((type < S2N_COL_I8) || (type > S2N_COL_F64) || (base < 0) || (base > 36))
+      return (EINVAL);
+
+   pcol->type   = type;
+   pcol->base   = base;
+   pcol->ppnull = ppnull ? ppnull : s2n_null_tokens;
+
+   return (col_reserve(pcol, capacity));
+} /* int str2col_init(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2col_append converts the fields of a buffer and appends them.
+\* ------------------------------------------------------------------------- */
+
+int str2col_append(s2n_col * pcol, const char * ps, size_t len, char delim)
+{
+   int err;
+
+   if(!pcol || !pcol->type || !valid_args(ps, delim, pcol->base))
+      return (EINVAL);
+
+   err = col_reserve(pcol, str2rows(ps, len, delim));
+   if(err)
+      return (err);
+
+   col_fn[pcol->type](pcol, ps, ps + len, delim);
+
+   return (0);
+} /* int str2col_append(s2n_col * pcol, const char * ps, size_t len, char delim) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2col_free releases the buffers of a column.
+\* ------------------------------------------------------------------------- */
+
+void str2col_free(s2n_col * pcol)
+{
+   if(pcol)
+   {
+      free64(pcol->pvalues);
+      free64(pcol->pvalidity);
+
+      pcol->pvalues    = NULL;
+      pcol->pvalidity  = NULL;
+      pcol->length     = 0;
+      pcol->null_count = 0;
+      pcol->errors     = 0;
+      pcol->capacity   = 0;
+   }
+} /* void str2col_free(s2n_col * pcol) */
+
+
+/* private data of the exported Arrow structures */
+typedef struct COL_EXPORT_S COL_EXPORT;
+struct COL_EXPORT_S
+{
+   const void * buffers[2]; /* validity bitmap and values */
+};
+
+
+/* ------------------------------------------------------------------------- *\
+   release_array is the release callback of the exported Arrow arrays.
+\* ------------------------------------------------------------------------- */
+
+static void release_array(struct ArrowArray * parray)
+{
+   COL_EXPORT * pce = (COL_EXPORT *) parray->private_data;
+
+   if(pce)
+   {
+      free64((void *) pce->buffers[0]);
+      free64((void *) pce->buffers[1]);
+      free(pce);
+   }
+
+   parray->private_data = NULL;
+   parray->release      = NULL;
+} /* void release_array(struct ArrowArray * parray) */
+
+
+/* ------------------------------------------------------------------------- *\
+   release_schema is the release callback of the exported Arrow schemas.
+\* ------------------------------------------------------------------------- */
+
+static void release_schema(struct ArrowSchema * pschema)
+{
+   if(pschema->private_data)
+      free(pschema->private_data); /* copy of the name */
+
+   pschema->private_data = NULL;
+   pschema->release      = NULL;
+} /* void release_schema(struct ArrowSchema * pschema) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2col_export moves the buffers of a column into an Arrow array.
+\* ------------------------------------------------------------------------- */
+
+int str2col_export(s2n_col * pcol, const char * name, struct ArrowArray * parray, struct ArrowSchema * pschema)
+{
+   COL_EXPORT * pce   = NULL;
+   char *       pname = NULL;
+
+   if(!pcol || !pcol->type || !parray || !pschema)
+      return (EINVAL);
+
+   if(!pcol->pvalues && col_reserve(pcol, 1))
+      return (ENOMEM); /* Arrow expects buffers even for empty arrays */
+
+   pce = (COL_EXPORT *) malloc(sizeof(COL_EXPORT));
+   if(name)
+      pname = (char *) malloc(strlen(name) + 1);
+
+   if(!pce || (name && !pname))
+   {
+      if(pce)
+         free(pce);
+      if(pname)
+         free(pname);
+      return (ENOMEM);
+   }
+
+   if(pname)
+      strcpy(pname, name);
+
+   pce->buffers[0] = pcol->pvalidity;
+   pce->buffers[1] = pcol->pvalues;
+
+   parray->length       = (int64_t) pcol->length;
+   parray->null_count   = (int64_t) pcol->null_count;
+   parray->offset       = 0;
+   parray->n_buffers    = 2;
+   parray->n_children   = 0;
+   parray->buffers      = pce->buffers;
+   parray->children     = NULL;
+   parray->dictionary   = NULL;
+   parray->release      = release_array;
+   parray->private_data = pce;
+
+   pschema->format       = col_format[pcol->type];
+   pschema->name         = pname;
+   pschema->metadata     = NULL;
+   pschema->flags        = ARROW_FLAG_NULLABLE;
+   pschema->n_children   = 0;
+   pschema->children     = NULL;
+   pschema->dictionary   = NULL;
+   pschema->release      = release_schema;
+   pschema->private_data = pname;
+
+   /* the buffers belong to the Arrow array now */
+   pcol->pvalues    = NULL;
+   pcol->pvalidity  = NULL;
+   pcol->length     = 0;
+   pcol->null_count = 0;
+   pcol->errors     = 0;
+   pcol->capacity   = 0;
+
+   return (0);
+} /* int str2col_export(...) */
+
+
+/* ========================================================================= *\
+   Parser contexts
+\* ========================================================================= */
+
+/* ------------------------------------------------------------------------- *\
+   s2n_ctx_init checks the options and initializes a parser context.
+\* ------------------------------------------------------------------------- */
+
+int s2n_ctx_init(s2n_ctx * pctx, int base, int flags, char decimal, char group, const char * const * ppnull)
+{
+   if(!pctx)
+      return (EINVAL);
+
+   memset(pctx, 0, sizeof(*pctx));
+
+   if((base < 0) || (base > 36) || (flags & ~(S2N_CTX_STRICT | S2N_CTX_PARTIAL | S2N_CTX_SATURATE)))
+      return (EINVAL);
+
+   /* The separators must not be mistaken for digits, signs or each other. */
+   if(!decimal || ((decimal != '.') && number_char(decimal)))
+      return (EINVAL);
+
+   if(group && (((group != '.') && number_char(group)) || (group == decimal)))
+      return (EINVAL);
+
+   pctx->base    = base;
+   pctx->flags   = flags;
+   pctx->decimal = decimal;
+   pctx->group   = group;
+   pctx->ppnull  = ppnull ? ppnull : s2n_null_tokens;
+
+   return (0);
+} /* int s2n_ctx_init(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   s2n_ctx_clear resets the counters and the first error of a context.
+\* ------------------------------------------------------------------------- */
+
+void s2n_ctx_clear(s2n_ctx * pctx)
+{
+   pctx->count  = 0;
+   pctx->nulls  = 0;
+   pctx->errors = 0;
+   pctx->perror = NULL;
+   pctx->error  = 0;
+} /* void s2n_ctx_clear(s2n_ctx * pctx) */
+
+
+#else /* STR2NUM_BATCH_C */
+
+/* ========================================================================= *\
+   Implementation of the typed buffer functions
+\* ========================================================================= */
+
+/* ------------------------------------------------------------------------- *\
+   PFN converts a field and returns 0 or the error value of the conversion.
+\* ------------------------------------------------------------------------- */
+
+static int PFN (const FIELD * pf, int base, VT * pv)
+{
+   char         buf[FIELD_BUF_SIZE];
+   char *       pheap = NULL;
+   const char * ps    = field_text(pf, buf, sizeof(buf), &pheap);
+   char *       pe    = NULL;
+   int          err   = ENOMEM;
+
+   if(ps)
+   {
+      *pv = PARSE(ps, &pe, base, &err);
+
+      if(!err && (pe != ps + pf->len))
+         err = EINVAL; /* the field contains more than a number */
+   }
+
+   if(pheap)
+      free(pheap);
+
+   return (err);
+} /* int PFN (const FIELD * pf, int base, VT * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   COL converts the fields of a buffer and appends them to a column.
+\* ------------------------------------------------------------------------- */
+
+static void COL (s2n_col * pcol, const char * ps, const char * pend, char delim)
+{
+   VT *      pv     = (VT *) pcol->pvalues + pcol->length;
+   uint8_t * pbits  = pcol->pvalidity;
+   size_t    i      = pcol->length;
+   size_t    nulls  = 0;
+   size_t    errors = 0;
+   int       base   = pcol->base;
+
+   PROBE3(batch_begin, ps, pend - ps, delim);
+
+   while(ps < pend)
+   {
+      FIELD f;
+      VT    v = 0;
+
+      ps = next_field(ps, pend, delim, &f);
+
+      if(!PFN(&f, base, &v))
+      {
+         pbits[i >> 3] |= (uint8_t) (1u << (i & 7));
+      }
+      else
+      {
+         if(!is_null_token(&f, pcol->ppnull))
+            ++errors;
+         ++nulls;
+         v = 0;
+      }
+
+      *pv++ = v;
+      ++i;
+   }
+
+   PROBE3(batch_end, pend, i - pcol->length, errors);
+
+   pcol->length      = i;
+   pcol->null_count += nulls;
+   pcol->errors     += errors;
+} /* void COL (s2n_col * pcol, const char * ps, const char * pend, char delim) */
+
+
+#ifdef AGG
+
+/* ------------------------------------------------------------------------- *\
+   AGG calculates sum, minimum, maximum and count of the values of a buffer.
+\* ------------------------------------------------------------------------- */
+
+int AGG (const char * ps, size_t len, char delim, int base, AT * pagg)
+{
+   int          err    = EINVAL;
+   const char * pend   = ps + len;
+   VT           sum    = 0;
+   VT           min    = V_MAX;
+   VT           max    = V_MIN;
+   size_t       count  = 0;
+   size_t       errors = 0;
+   int          ovf    = 0;
+
+   if(!pagg || !valid_args(ps, delim, base))
+      goto Exit;
+
+   PROBE3(batch_begin, ps, len, delim);
+
+   while(ps < pend)
+   {
+      FIELD f;
+      VT    v = 0;
+
+      ps = next_field(ps, pend, delim, &f);
+
+      if(PFN(&f, base, &v))
+      {
+         ++errors;
+         continue;
+      }
+
+      SUM_ADD(sum, v, ovf);
+
+      if(v < min)
+         min = v;
+
+      if(v > max)
+         max = v;
+
+      ++count;
+   }
+
+   PROBE3(batch_end, pend, count + errors, errors);
+
+   err = 0;
+
+Exit:;
+
+   if(pagg)
+   {
+      pagg->sum      = sum;
+      pagg->min      = min;
+      pagg->max      = max;
+      pagg->count    = count;
+      pagg->errors   = errors;
+      pagg->overflow = ovf;
+   }
+
+   return (err);
+} /* int AGG (const char * ps, size_t len, char delim, int base, AT * pagg) */
+
+
+/* ------------------------------------------------------------------------- *\
+   AGG_JOB is the job function of AGG_MT
+\* ------------------------------------------------------------------------- */
+
+static int AGG_JOB (const char * ps, size_t len, char delim, int base, void * pres)
+{
+   return (AGG(ps, len, delim, base, (AT *) pres));
+} /* int AGG_JOB (const char * ps, size_t len, char delim, int base, void * pres) */
+
+
+/* ------------------------------------------------------------------------- *\
+   AGG_MT calculates the aggregates of a buffer by several threads.
+\* ------------------------------------------------------------------------- */
+
+int AGG_MT (const char * ps, size_t len, char delim, int base, int threads, AT * pagg)
+{
+   int  err = EINVAL;
+   AT * pparts;
+   int  i;
+
+   if(!pagg || !valid_args(ps, delim, base))
+      return (AGG(ps, len, delim, base, pagg));
+
+   threads = batch_threads(len, threads);
+   if(threads < 2)
+      return (AGG(ps, len, delim, base, pagg));
+
+   pparts = (AT *) malloc(threads * sizeof(AT));
+   if(!pparts)
+      return (AGG(ps, len, delim, base, pagg));
+
+   err = run_parallel(ps, len, delim, base, threads, AGG_JOB, pparts, sizeof(AT));
+   if(err)
+   {
+      free(pparts);
+      return (AGG(ps, len, delim, base, pagg));
+   }
+
+   *pagg = pparts[0];
+
+   for(i = 1; i < threads; ++i)
+   {
+      const AT * pp = pparts + i;
+
+      SUM_ADD(pagg->sum, pp->sum, pagg->overflow);
+
+      if(pp->min < pagg->min)
+         pagg->min = pp->min;
+
+      if(pp->max > pagg->max)
+         pagg->max = pp->max;
+
+      pagg->count    += pp->count;
+      pagg->errors   += pp->errors;
+      pagg->overflow |= pp->overflow;
+   }
+
+   free(pparts);
+
+   return (err);
+} /* int AGG_MT (...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   SEL selects the rows of a buffer which values are in the range lo - hi.
+\* ------------------------------------------------------------------------- */
+
+int SEL (const char * ps, size_t len, char delim, int base, VT lo, VT hi, s2n_sel * psel)
+{
+   int          err     = EINVAL;
+   const char * pend    = ps + len;
+   size_t *     prow    = NULL;
+   uint8_t *    pbits   = NULL;
+   size_t       limit   = ~(size_t) 0;
+   size_t       rows    = 0;
+   size_t       matches = 0;
+   size_t       errors  = 0;
+   unsigned     bits    = 0;
+
+   if(!psel || !valid_args(ps, delim, base))
+      goto Exit;
+
+   prow  = psel->prow;
+   pbits = psel->pbits;
+
+   if(prow || pbits)
+      limit = psel->size;
+
+   err = 0;
+
+   PROBE3(batch_begin, ps, len, delim);
+
+   while(ps < pend)
+   {
+      FIELD f;
+      VT    v     = 0;
+      int   match = 0;
+
+      if(rows == limit)
+      {
+         err = ENOBUFS;
+         break;
+      }
+
+      ps = next_field(ps, pend, delim, &f);
+
+      if((base != 10) || !EARLY(&f, lo, hi))
+      {
+         if(PFN(&f, base, &v))
+         {
+            ++errors;
+         }
+         else if((v >= lo) && (v <= hi))
+         {
+            if(prow)
+               prow[matches] = rows;
+            ++matches;
+            match = 1;
+         }
+      }
+
+      bits |= (unsigned) match << (rows & 7);
+
+      if(!(++rows & 7))
+      {
+         if(pbits)
+            pbits[(rows - 1) >> 3] = (uint8_t) bits;
+         bits = 0;
+      }
+   }
+
+   if(pbits && (rows & 7))
+      pbits[rows >> 3] = (uint8_t) bits;
+
+   PROBE3(batch_end, pend, rows, errors);
+
+Exit:;
+
+   if(psel)
+   {
+      psel->rows    = rows;
+      psel->matches = matches;
+      psel->errors  = errors;
+   }
+
+   return (err);
+} /* int SEL (...) */
+
+#endif /* AGG */
+
+
+#ifdef CTX
+
+/* ------------------------------------------------------------------------- *\
+   CTX converts a field with the options of a parser context and accumulates
+   the errors in the context.
+\* ------------------------------------------------------------------------- */
+
+VT CTX (s2n_ctx * pctx, const char * ps, size_t len)
+{
+   char         buf[FIELD_BUF_SIZE];
+   char *       pheap = NULL;
+   const char * pt;
+   char *       pe    = NULL;
+   int          err   = ENOMEM;
+   VT           v     = 0;
+   FIELD        f;
+
+   f.ps   = ps;
+   f.len  = len;
+   f.term = 0; /* ps[len] may be beyond the end of the buffer */
+
+   if(!(pctx->flags & S2N_CTX_STRICT))
+   {
+      while(f.len && IS_BLANK(*f.ps))
+      {
+         ++f.ps;
+         --f.len;
+      }
+
+      while(f.len && IS_BLANK(f.ps[f.len - 1]))
+      {
+         --f.len;
+         f.term = 1;
+      }
+   }
+
+   if(pctx->group || (DEC(pctx) != '.'))
+   {
+      pt = field_filter(&f, pctx->group, DEC(pctx), buf, sizeof(buf), &pheap, &len);
+   }
+   else
+   {
+      pt  = field_text(&f, buf, sizeof(buf), &pheap);
+      len = f.len;
+   }
+
+   if(pt)
+   {
+      if(IS_BLANK(*pt))
+         err = EINVAL; /* the conversion functions would skip leading blanks */
+      else
+         v = PARSE(pt, &pe, pctx->base, &err);
+
+      if((err == ERANGE) && (pctx->flags & S2N_CTX_SATURATE))
+         err = 0;
+
+      if(!err && (pe != pt + len) && !(pctx->flags & S2N_CTX_PARTIAL))
+         err = EINVAL; /* the field contains more than a number */
+   }
+
+   if(pheap)
+      free(pheap);
+
+   if(!err)
+   {
+      ++pctx->count;
+      return (v);
+   }
+
+   if(is_null_token(&f, pctx->ppnull))
+   {
+      ++pctx->nulls;
+      return (0);
+   }
+
+   if(!pctx->errors++)
+   {
+      pctx->perror = ps;
+      pctx->error  = err;
+   }
+
+   return (0);
+} /* VT CTX (s2n_ctx * pctx, const char * ps, size_t len) */
+
+#endif /* CTX */
+
+
+#undef AGG
+#undef AGG_MT
+#undef AGG_JOB
+#undef SEL
+#undef EARLY
+#undef AT
+#undef VT
+#undef V_MIN
+#undef V_MAX
+#undef PFN
+#undef PARSE
+#undef SUM_ADD
+#undef COL
+#undef CTX
+#undef DEC
+
+#endif /* STR2NUM_BATCH_C */
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -0,0 +1,277 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num_batch.h                                              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : buffer conversion functions of str2num_batch.c               *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#ifndef STR2NUM_BATCH_H
+#define STR2NUM_BATCH_H
+
+
+#include <str2num.h>
+
+#ifndef S2N_MT_MIN_CHUNK
+/* S2N_MT_MIN_CHUNK is the minimum number of bytes that a thread of the parallel
+   functions is started for. Smaller buffers are processed by less threads. */
+
+#define S2N_MT_MIN_CHUNK 0x10000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The buffer functions process len bytes at ps that contain fields which are separated
+   by the delimiter delim. The buffer doesn't need to be terminated. A delimiter at the
+   very end of the buffer doesn't start another field. Leading and trailing blanks of
+   the fields are ignored and all other fields that don't contain a single valid number
+   are counted as errors. The delimiter must not be a character that may be part of a
+   number (letters, digits, '+', '-', '.' and '~'). Common delimiters like ',', ';', '\t',
+   ' ', '\n' or '|' are fine. The functions return 0 or EINVAL in case of invalid arguments.
+   The *_mt variants split the buffer at delimiters and process the parts by up to threads
+   threads which results are merged afterwards. If threads is 0 then the number of online
+   CPUs is used. */
+
+/* aggregates of a buffer of signed integers
+   The sum wraps around and overflow is set to nonzero in case of an overflow.
+   min and max are only valid if count is nonzero. */
+typedef struct s2n_agg_i64_s s2n_agg_i64;
+struct s2n_agg_i64_s
+{
+   int64_t  sum;      /* sum of the valid values */
+   int64_t  min;      /* minimum of the valid values */
+   int64_t  max;      /* maximum of the valid values */
+   size_t   count;    /* number of valid values */
+   size_t   errors;   /* number of fields without a valid value */
+   int      overflow; /* nonzero if the sum did overflow */
+};
+
+/* aggregates of a buffer of unsigned integers */
+typedef struct s2n_agg_u64_s s2n_agg_u64;
+struct s2n_agg_u64_s
+{
+   uint64_t sum;      /* sum of the valid values */
+   uint64_t min;      /* minimum of the valid values */
+   uint64_t max;      /* maximum of the valid values */
+   size_t   count;    /* number of valid values */
+   size_t   errors;   /* number of fields without a valid value */
+   int      overflow; /* nonzero if the sum did overflow */
+};
+
+/* aggregates of a buffer of floating point numbers
+   NaN values are counted and propagate into the sum but don't change min and max.
+   overflow is always 0 because an overflowing sum is an infinite value. */
+typedef struct s2n_agg_d_s s2n_agg_d;
+struct s2n_agg_d_s
+{
+   double   sum;      /* sum of the valid values */
+   double   min;      /* minimum of the valid values */
+   double   max;      /* maximum of the valid values */
+   size_t   count;    /* number of valid values */
+   size_t   errors;   /* number of fields without a valid value */
+   int      overflow; /* always 0 */
+};
+
+/* str2agg_* calculate the aggregates of a buffer without storing any of the values. */
+int str2agg_i64    (const char * ps, size_t len, char delim, int base, s2n_agg_i64 * pagg);
+int str2agg_u64    (const char * ps, size_t len, char delim, int base, s2n_agg_u64 * pagg);
+int str2agg_d      (const char * ps, size_t len, char delim, int base, s2n_agg_d   * pagg);
+
+int str2agg_i64_mt (const char * ps, size_t len, char delim, int base, int threads, s2n_agg_i64 * pagg);
+int str2agg_u64_mt (const char * ps, size_t len, char delim, int base, int threads, s2n_agg_u64 * pagg);
+int str2agg_d_mt   (const char * ps, size_t len, char delim, int base, int threads, s2n_agg_d   * pagg);
+
+
+/* selection of the rows of a buffer which values are in a range */
+typedef struct s2n_sel_s s2n_sel;
+struct s2n_sel_s
+{
+   size_t *  prow;    /* optional array that receives the indices of the matching rows */
+   uint8_t * pbits;   /* optional selection bitmap with a bit for each row (least significant bit first) */
+   size_t    size;    /* number of rows that prow and pbits can take */
+   size_t    rows;    /* number of scanned rows */
+   size_t    matches; /* number of matching rows */
+   size_t    errors;  /* number of rows without a valid number */
+};
+
+/* str2rows returns the number of rows (fields) of a buffer. */
+size_t str2rows (const char * ps, size_t len, char delim);
+
+/* str2sel_* select the rows which values are within the range lo <= value <= hi.
+   The functions return ENOBUFS and stop at psel->size rows if the buffer contains more rows
+   and prow or pbits is set. Decimal integers that are out of range because of their number
+   of digits are rejected without a conversion. */
+int str2sel_i64 (const char * ps, size_t len, char delim, int base, int64_t  lo, int64_t  hi, s2n_sel * psel);
+int str2sel_u64 (const char * ps, size_t len, char delim, int base, uint64_t lo, uint64_t hi, s2n_sel * psel);
+int str2sel_d   (const char * ps, size_t len, char delim, int base, double   lo, double   hi, s2n_sel * psel);
+
+
+/* types of the columns of str2col_* */
+#define S2N_COL_I8   1  /* int8_t   */
+#define S2N_COL_U8   2  /* uint8_t  */
+#define S2N_COL_I16  3  /* int16_t  */
+#define S2N_COL_U16  4  /* uint16_t */
+#define S2N_COL_I32  5  /* int32_t  */
+#define S2N_COL_U32  6  /* uint32_t */
+#define S2N_COL_I64  7  /* int64_t  */
+#define S2N_COL_U64  8  /* uint64_t */
+#define S2N_COL_F32  9  /* float    */
+#define S2N_COL_F64 10  /* double   */
+
+/* column of values with a validity bitmap in the layout of Apache Arrow */
+typedef struct s2n_col_s s2n_col;
+struct s2n_col_s
+{
+   int                  type;       /* S2N_COL_* type of the values */
+   int                  base;       /* numeric base of the values */
+   size_t               length;     /* number of values */
+   size_t               null_count; /* number of null values */
+   size_t               errors;     /* number of invalid values that are stored as null values */
+   size_t               capacity;   /* number of values that fit into the buffers */
+   void *               pvalues;    /* 64 byte aligned buffer of the values */
+   uint8_t *            pvalidity;  /* 64 byte aligned validity bitmap, a set bit marks a valid value */
+   const char * const * ppnull;     /* NULL terminated list of the null tokens */
+};
+
+/* default null tokens "", "NA", "null" and "-" */
+extern const char * const s2n_null_tokens[];
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+/* structures of the Arrow C data interface (https://arrow.apache.org/docs/format/CDataInterface.html) */
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE           2
+#define ARROW_FLAG_MAP_KEYS_SORTED    4
+
+struct ArrowSchema
+{
+   const char *          format;
+   const char *          name;
+   const char *          metadata;
+   int64_t               flags;
+   int64_t               n_children;
+   struct ArrowSchema ** children;
+   struct ArrowSchema *  dictionary;
+   void               (* release) (struct ArrowSchema *);
+   void *                private_data;
+};
+
+struct ArrowArray
+{
+   int64_t               length;
+   int64_t               null_count;
+   int64_t               offset;
+   int64_t               n_buffers;
+   int64_t               n_children;
+   const void **         buffers;
+   struct ArrowArray **  children;
+   struct ArrowArray *   dictionary;
+   void               (* release) (struct ArrowArray *);
+   void *                private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+/* str2col_init initializes an empty column for at least capacity values.
+   ppnull is a NULL terminated list of tokens that are stored as null values. If ppnull is
+   NULL then s2n_null_tokens are used. The tokens are compared with the fields without
+   leading and trailing blanks that are no valid number. All other invalid fields are stored
+   as null values too but are counted in errors as well. */
+int  str2col_init   (s2n_col * pcol, int type, int base, size_t capacity, const char * const * ppnull);
+
+/* str2col_append converts the fields of a delimited buffer and appends them to the column. */
+int  str2col_append (s2n_col * pcol, const char * ps, size_t len, char delim);
+
+/* str2col_export moves the buffers of the column into an Arrow array with a matching schema.
+   The column is empty afterwards and the release callbacks of the Arrow structures free the
+   buffers. name is an optional name of the field of the schema. */
+int  str2col_export (s2n_col * pcol, const char * name, struct ArrowArray * parray, struct ArrowSchema * pschema);
+
+/* str2col_free releases the buffers of a column. */
+void str2col_free   (s2n_col * pcol);
+
+
+/* flags of the parser contexts */
+#define S2N_CTX_STRICT   0x01  /* reject fields with leading or trailing blanks */
+#define S2N_CTX_PARTIAL  0x02  /* accept fields with other characters after the number */
+#define S2N_CTX_SATURATE 0x04  /* integers out of range are clamped instead of being errors */
+
+/* parser context with preconfigured options that accumulates the errors of many fields */
+typedef struct s2n_ctx_s s2n_ctx;
+struct s2n_ctx_s
+{
+   int                  base;    /* numeric base of the values */
+   int                  flags;   /* S2N_CTX_* flags */
+   char                 decimal; /* decimal separator of floating point numbers */
+   char                 group;   /* group separator that is removed from the numbers or '\0' */
+   const char * const * ppnull;  /* NULL terminated list of the null tokens */
+   size_t               count;   /* number of valid values */
+   size_t               nulls;   /* number of null tokens */
+   size_t               errors;  /* number of invalid fields */
+   const char *         perror;  /* first invalid field or NULL */
+   int                  error;   /* error value of the first invalid field */
+};
+
+/* s2n_ctx_init validates the options once and initializes a parser context.
+   decimal is the decimal separator of floating point numbers and group is a separator of
+   digit groups that is removed before the conversion or '\0'. Both must differ and must
+   not be characters that may be part of a number except of a '.'. ppnull is a NULL terminated
+   list of null tokens or NULL for s2n_null_tokens. The function returns 0 or EINVAL. */
+int      s2n_ctx_init  (s2n_ctx * pctx, int base, int flags, char decimal, char group, const char * const * ppnull);
+
+/* s2n_ctx_clear resets the counters and the first error of a context. */
+void     s2n_ctx_clear (s2n_ctx * pctx);
+
+/* s2n_ctx_* convert a field of len bytes at ps without checking the arguments again.
+   Leading and trailing blanks of the field are ignored unless S2N_CTX_STRICT is set.
+   Null tokens return 0 and are counted in nulls. Invalid fields return 0 as well and
+   are counted in errors which stays set until s2n_ctx_clear. The position and error
+   value of the first invalid field are stored in perror and error. The field doesn't need
+   to be terminated and the functions never read ps[len]. */
+int64_t  s2n_ctx_i64   (s2n_ctx * pctx, const char * ps, size_t len);
+uint64_t s2n_ctx_u64   (s2n_ctx * pctx, const char * ps, size_t len);
+double   s2n_ctx_d     (s2n_ctx * pctx, const char * ps, size_t len);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif
+
+#endif /* STR2NUM_BATCH_H */
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
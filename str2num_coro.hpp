@@ -0,0 +1,316 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num_coro.hpp                                             *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : incremental C++20 coroutine parser of delimited numbers      *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#ifndef STR2NUM_CORO_HPP
+#define STR2NUM_CORO_HPP
+
+
+#include <array>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <utility>
+
+#include <str2num.hpp>
+
+#if !defined (__cpp_impl_coroutine)
+#error "str2num_coro.hpp requires C++20 coroutines"
+#endif
+
+#ifndef S2N_CORO_TOKEN_SIZE
+/* S2N_CORO_TOKEN_SIZE is the maximum length of a field that is split across two or more
+   buffers. The start of such a field is kept in the coroutine frame until the rest of it
+   arrives. Longer split fields return std::errc::value_too_large. */
+
+#define S2N_CORO_TOKEN_SIZE 256
+#endif
+
+
+/* s2n::number_parser<T> is a generator coroutine that converts the numbers of a stream of
+   buffers that are separated by the delimiter delim like the fields of str2num_batch.h,
+   e.g. the buffers of the asynchronous reads of a socket. Fields that are split across
+   buffers are continued with the next buffer without blocking or buffering the stream.
+   The fields are converted by s2n::str2int_r or s2n::str2flt_r like s2n::numbers does.
+
+   feed hands over the next buffer which must stay valid until next returns false again.
+   next returns true and stores the value and the error of the next field or returns false
+   if the parser requires the next buffer. finish marks the end of the stream. After it
+   next returns the last field if there is one and false afterwards and done is true then.
+   feed and finish return false if the parser doesn't wait for a buffer. */
+
+namespace s2n
+{
+
+/* ------------------------------------------------------------------------- *\
+   number_parser is a generator coroutine that converts the numbers of a
+   stream of buffers.
+\* ------------------------------------------------------------------------- */
+
+template <typename T>
+class number_parser
+{
+   static_assert((std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value) || std::is_floating_point<T>::value,
+                 "s2n::number_parser supports integer and floating point types only");
+
+   /* value and error of a field */
+   struct result
+   {
+      T         value;
+      std::errc ec;
+   };
+
+   /* buffer that is handed over to the coroutine */
+   struct chunk
+   {
+      std::string_view buf;
+      bool             last;
+   };
+
+public:
+   struct promise_type
+   {
+      std::string_view input;           /* buffer of feed */
+      T                value   = T(0);  /* value of the last field */
+      std::errc        ec      = std::errc();
+      bool             waiting = false; /* the coroutine waits for the next buffer */
+      bool             fed     = false; /* feed or finish handed over the next buffer */
+      bool             last    = false; /* finish marked the end of the stream */
+      bool             ready   = false; /* value and ec belong to a new field */
+
+      number_parser get_return_object() { return (number_parser(std::coroutine_handle<promise_type>::from_promise(*this))); }
+
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+
+      std::suspend_always yield_value(result r) noexcept
+      {
+         value = r.value;
+         ec    = r.ec;
+         ready = true;
+         return {};
+      }
+
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+   };
+
+   explicit number_parser(char delim = ',', int base = 10) : number_parser(run(delim, base))
+   {
+      h.resume(); /* run up to the wait for the first buffer */
+   }
+
+   number_parser(number_parser && o) noexcept : h(std::exchange(o.h, nullptr)) {}
+
+   number_parser & operator = (number_parser && o) noexcept
+   {
+      if(this != &o)
+      {
+         if(h)
+            h.destroy();
+         h = std::exchange(o.h, nullptr);
+      }
+      return (*this);
+   }
+
+   number_parser(const number_parser &) = delete;
+   number_parser & operator = (const number_parser &) = delete;
+
+   ~number_parser()
+   {
+      if(h)
+         h.destroy();
+   }
+
+   /* feed hands over the next buffer of the stream */
+   bool feed(std::string_view buf)
+   {
+      promise_type & p = h.promise();
+
+      if(!p.waiting || p.fed || p.last)
+         return (false);
+
+      p.input = buf;
+      p.fed   = true;
+      return (true);
+   }
+
+   /* finish marks the end of the stream */
+   bool finish()
+   {
+      promise_type & p = h.promise();
+
+      if(!p.waiting || p.fed || p.last)
+         return (false);
+
+      p.input = std::string_view();
+      p.fed   = true;
+      p.last  = true;
+      return (true);
+   }
+
+   /* next converts the next field of the stream */
+   bool next(T & value, std::errc & ec)
+   {
+      promise_type & p = h.promise();
+
+      if(h.done() || (p.waiting && !p.fed))
+         return (false);
+
+      p.ready = false;
+      h.resume();
+
+      if(!p.ready)
+         return (false);
+
+      value = p.value;
+      ec    = p.ec;
+      return (true);
+   }
+
+   /* done returns true after the last field of a finished stream */
+   bool done() const { return (h.done()); }
+
+private:
+   std::coroutine_handle<promise_type> h;
+
+   explicit number_parser(std::coroutine_handle<promise_type> hc) : h(hc) {}
+
+   /* input is the awaitable of the next buffer */
+   struct input
+   {
+      promise_type * pp = nullptr;
+
+      bool await_ready() const noexcept { return (false); }
+
+      void await_suspend(std::coroutine_handle<promise_type> hc) noexcept
+      {
+         pp          = &hc.promise();
+         pp->waiting = true;
+      }
+
+      chunk await_resume() noexcept
+      {
+         pp->waiting = false;
+         pp->fed     = false;
+         return (chunk { pp->input, pp->last });
+      }
+   };
+
+   static result convert(const char * ps, const char * pend, int base)
+   {
+      result r { T(0), std::errc() };
+
+      r.ec = detail::errc(detail::field<T>(ps, pend, base, r.value));
+      return (r);
+   }
+
+   /* run is the body of the coroutine that keeps the start of split fields in token */
+   static number_parser run(char delim, int base)
+   {
+      std::array<char, S2N_CORO_TOKEN_SIZE> token;
+      size_t                                tlen    = 0;     /* length of the start of a split field */
+      bool                                  split   = false; /* a field of a previous buffer continues */
+      bool                                  toolong = false; /* the split field doesn't fit into token */
+
+      for(;;)
+      {
+         chunk        in   = co_await input {};
+         const char * ps   = in.buf.data();
+         const char * pend = ps + in.buf.size();
+
+         while(ps < pend)
+         {
+            const char * pd = std::char_traits<char>::find(ps, (size_t) (pend - ps), delim);
+
+            if(split || !pd)
+            {
+               const char * pe = pd ? pd : pend;
+               size_t       n  = (size_t) (pe - ps);
+
+               if(n > token.size() - tlen)
+               {
+                  toolong = true;
+               }
+               else if(!toolong)
+               {
+                  std::memcpy(token.data() + tlen, ps, n);
+                  tlen += n;
+               }
+
+               split = true;
+
+               if(!pd)
+                  break; /* the field continues in the next buffer */
+
+               if(toolong)
+                  co_yield result { T(0), std::errc::value_too_large };
+               else
+                  co_yield convert(token.data(), token.data() + tlen, base);
+
+               tlen    = 0;
+               split   = false;
+               toolong = false;
+            }
+            else
+            {
+               co_yield convert(ps, pd, base);
+            }
+
+            ps = pd + 1;
+         }
+
+         if(in.last)
+         {
+            if(toolong)
+               co_yield result { T(0), std::errc::value_too_large };
+            else if(split)
+               co_yield convert(token.data(), token.data() + tlen, base);
+
+            co_return;
+         }
+      }
+   } /* number_parser run(char delim, int base) */
+}; /* class number_parser */
+
+} /* namespace s2n */
+
+#endif /* STR2NUM_CORO_HPP */
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -0,0 +1,1121 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num_file.c                                               *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : cache and index files of text files with numbers             *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#include <errno.h>
+#include <stdio.h>  /* fopen */
+#include <stdlib.h> /* malloc */
+#include <string.h> /* memcmp */
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined (_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined (_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <str2num_file.h>
+
+/* extension of the default names of the cache files */
+#define CACHE_EXT ".s2n"
+
+/* offset of the values in the cache files */
+#define CACHE_DATA 128
+
+#define CACHE_MAGIC   "S2NCACHE"
+#define CACHE_VERSION 2
+#define BYTE_ORDER_ID 0x01020304
+
+/* extension of the default names of the index files */
+#define INDEX_EXT ".s2i"
+
+/* offset of the row offsets in the index files */
+#define INDEX_DATA 64
+
+#define INDEX_MAGIC   "S2NINDEX"
+#define INDEX_VERSION 2
+
+/* size of the local buffer for copies of the last row */
+#define ROW_BUF_SIZE 128
+
+/* A source file must be older than its cache or index file by this number of nanoseconds,
+   otherwise it may have been rewritten within the granularity of the file times and its
+   checksum is compared too (file systems like FAT store times of 2 seconds). */
+#define RACY_TIME 2000000000ll
+
+#define ALIGN64(x) (((x) + 63) & ~(uint64_t) 63)
+
+#define IS_BLANK(c) (((c) == ' ') || (((c) >= 0x9) && ((c) <= 0xd)))
+
+
+/* ========================================================================= *\
+   Helper functions
+\* ========================================================================= */
+
+/* header of the cache files */
+typedef struct CACHE_HEADER_S CACHE_HEADER;
+struct CACHE_HEADER_S
+{
+   char     magic[8];     /* CACHE_MAGIC */
+   uint32_t version;      /* CACHE_VERSION */
+   uint32_t byte_order;   /* BYTE_ORDER_ID in the byte order of the writer */
+   uint32_t type;         /* S2N_COL_* type of the values */
+   uint32_t value_size;   /* size of a value */
+   uint64_t count;        /* number of values */
+   uint64_t null_count;   /* number of null values */
+   uint64_t errors;       /* number of invalid fields */
+   uint64_t src_size;     /* size of the source file */
+   int64_t  src_mtime;    /* modification time of the source file in ns */
+   uint64_t src_checksum; /* checksum of the source file */
+   uint8_t  reserved[CACHE_DATA - 72];
+};
+
+/* read only mapping of a file */
+typedef struct MAP_S MAP;
+struct MAP_S
+{
+   const uint8_t * pdata; /* start of the mapping */
+   size_t          size;  /* size of the file */
+   void *          hmap;  /* handle of the mapping (Windows only) */
+};
+
+/* header of the index files */
+typedef struct INDEX_HEADER_S INDEX_HEADER;
+struct INDEX_HEADER_S
+{
+   char     magic[8];     /* INDEX_MAGIC */
+   uint32_t version;      /* INDEX_VERSION */
+   uint32_t byte_order;   /* BYTE_ORDER_ID in the byte order of the writer */
+   uint32_t width;        /* size of the offsets (4 or 8) */
+   uint32_t delim;        /* delimiter of the rows */
+   uint64_t rows;         /* number of rows */
+   uint64_t src_size;     /* size of the source file */
+   int64_t  src_mtime;    /* modification time of the source file in ns */
+   uint64_t src_checksum; /* checksum of the source file */
+   uint8_t  reserved[INDEX_DATA - 56];
+};
+
+/* entry of the cache of converted values of an index */
+typedef struct INDEX_ENTRY_S INDEX_ENTRY;
+struct INDEX_ENTRY_S
+{
+   size_t row;  /* row of the value */
+   int    type; /* S2N_COL_* type of the value or 0 for unused entries */
+   int    err;  /* result of the conversion */
+   union
+   {
+      int64_t  i;
+      uint64_t u;
+      double   d;
+   } v;
+};
+
+/* sizes of the values of the column types */
+static const uint8_t value_size[] = { 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+
+/* ------------------------------------------------------------------------- *\
+   file_info retrieves the size and modification time of a file. The time is
+   returned in nanoseconds since 1970 and in seconds only on systems without
+   the nanoseconds of struct stat.
+\* ------------------------------------------------------------------------- */
+
+static int file_info(const char * path, uint64_t * psize, int64_t * pmtime)
+{
+#if defined (_WIN32)
+   WIN32_FILE_ATTRIBUTE_DATA fa;
+
+   if(!GetFileAttributesExA(path, GetFileExInfoStandard, &fa))
+      return ((GetLastError() == ERROR_FILE_NOT_FOUND) ? ENOENT : EACCES);
+
+   *psize  = ((uint64_t) fa.nFileSizeHigh << 32) | fa.nFileSizeLow;
+   *pmtime = (int64_t) ((((uint64_t) fa.ftLastWriteTime.dwHighDateTime << 32) | fa.ftLastWriteTime.dwLowDateTime) -
+                        116444736000000000ull) * 100; /* 100 ns since 1601 */
+#else
+   struct stat st;
+
+   if(stat(path, &st))
+      return (errno ? errno : ENOENT);
+
+   *psize  = (uint64_t) st.st_size;
+#if defined (__APPLE__)
+   *pmtime = (int64_t) st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#elif defined (st_mtime)
+   /* st_mtime is a macro of st_mtim.tv_sec if the system knows the nanoseconds */
+   *pmtime = (int64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+   *pmtime = (int64_t) st.st_mtime * 1000000000;
+#endif
+#endif
+
+   return (0);
+} /* int file_info(const char * path, uint64_t * psize, int64_t * pmtime) */
+
+
+/* ------------------------------------------------------------------------- *\
+   is_racy checks if a source file with the modification time src_mtime may
+   have been rewritten with the same size and time after the cache or index
+   file pname was written. This is the case if the source file is not clearly
+   older than pname.
+\* ------------------------------------------------------------------------- */
+
+static int is_racy(const char * pname, int64_t src_mtime)
+{
+   uint64_t size;
+   int64_t  mtime;
+
+   if(file_info(pname, &size, &mtime))
+      return (1);
+
+   return (src_mtime > mtime - RACY_TIME);
+} /* int is_racy(const char * pname, int64_t src_mtime) */
+
+
+/* ------------------------------------------------------------------------- *\
+   map_file maps a whole file into memory for reading.
+   Empty files result in a NULL pointer with a size of 0.
+\* ------------------------------------------------------------------------- */
+
+static int map_file(const char * path, MAP * pm)
+{
+   int err = 0;
+
+   pm->pdata = NULL;
+   pm->size  = 0;
+   pm->hmap  = NULL;
+
+#if defined (_WIN32)
+   {
+      HANDLE        hf = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      LARGE_INTEGER li;
+
+      if(hf == INVALID_HANDLE_VALUE)
+         return ((GetLastError() == ERROR_FILE_NOT_FOUND) ? ENOENT : EACCES);
+
+      if(!GetFileSizeEx(hf, &li) || ((uint64_t) li.QuadPart > (size_t) -1))
+      {
+         err = EFBIG;
+      }
+      else if(li.QuadPart)
+      {
+         pm->hmap = CreateFileMappingA(hf, NULL, PAGE_READONLY, 0, 0, NULL);
+         if(pm->hmap)
+            pm->pdata = (const uint8_t *) MapViewOfFile(pm->hmap, FILE_MAP_READ, 0, 0, 0);
+
+         if(pm->pdata)
+         {
+            pm->size = (size_t) li.QuadPart;
+         }
+         else
+         {
+            if(pm->hmap)
+               CloseHandle(pm->hmap);
+            pm->hmap = NULL;
+            err = ENOMEM;
+         }
+      }
+
+      CloseHandle(hf);
+   }
+#else
+   {
+      struct stat st;
+      int         fd = open(path, O_RDONLY);
+
+      if(fd < 0)
+         return (errno ? errno : ENOENT);
+
+      if(fstat(fd, &st) || ((uint64_t) st.st_size > (size_t) -1))
+      {
+         err = EFBIG;
+      }
+      else if(st.st_size)
+      {
+         void * p = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+         if(p == MAP_FAILED)
+         {
+            err = errno ? errno : ENOMEM;
+         }
+         else
+         {
+            pm->pdata = (const uint8_t *) p;
+            pm->size  = (size_t) st.st_size;
+         }
+      }
+
+      close(fd);
+   }
+#endif
+
+   return (err);
+} /* int map_file(const char * path, MAP * pm) */
+
+
+/* ------------------------------------------------------------------------- *\
+   unmap_file releases a mapping of map_file.
+\* ------------------------------------------------------------------------- */
+
+static void unmap_file(MAP * pm)
+{
+   if(pm->pdata)
+   {
+#if defined (_WIN32)
+      UnmapViewOfFile(pm->pdata);
+      CloseHandle(pm->hmap);
+#else
+      munmap((void *) pm->pdata, pm->size);
+#endif
+   }
+
+   pm->pdata = NULL;
+   pm->size  = 0;
+   pm->hmap  = NULL;
+} /* void unmap_file(MAP * pm) */
+
+
+/* ------------------------------------------------------------------------- *\
+   checksum calculates a 64 bit checksum of a buffer. It processes 32 bytes
+   in four independent lanes per loop for a fast verification of large files.
+\* ------------------------------------------------------------------------- */
+
+static uint64_t checksum(const uint8_t * p, size_t len)
+{
+   const uint64_t k = 0x9e3779b97f4a7c15ULL;
+   uint64_t       h[4];
+   uint64_t       w;
+   size_t         i;
+
+   h[0] = len;
+   h[1] = len ^ k;
+   h[2] = ~len;
+   h[3] = ~len ^ k;
+
+   while(len >= 32)
+   {
+      for(i = 0; i < 4; ++i)
+      {
+         memcpy(&w, p + i * 8, 8);
+         h[i] = (h[i] ^ w) * k;
+         h[i] ^= h[i] >> 29;
+      }
+      p   += 32;
+      len -= 32;
+   }
+
+   while(len)
+   {
+      w = 0;
+      i = (len < 8) ? len : 8;
+      memcpy(&w, p, i);
+      h[0] = (h[0] ^ w) * k;
+      h[0] ^= h[0] >> 29;
+      p   += i;
+      len -= i;
+   }
+
+   w = h[0];
+   for(i = 1; i < 4; ++i)
+   {
+      w = (w ^ h[i]) * k;
+      w ^= w >> 32;
+   }
+
+   return (w);
+} /* uint64_t checksum(const uint8_t * p, size_t len) */
+
+
+/* ------------------------------------------------------------------------- *\
+   cache_name returns the name of the cache file of a source file.
+   The returned name must be released by free.
+\* ------------------------------------------------------------------------- */
+
+static char * cache_name(const char * psrc, const char * pcache, const char * pext)
+{
+   size_t len;
+   char * pname;
+
+   if(!pcache)
+   {
+      if(!psrc)
+         return (NULL);
+      pcache = psrc;
+   }
+   else
+   {
+      pext = "";
+   }
+
+   len   = strlen(pcache);
+   pname = (char *) malloc(len + strlen(pext) + 1);
+   if(pname)
+   {
+      memcpy(pname, pcache, len);
+      strcpy(pname + len, pext);
+   }
+
+   return (pname);
+} /* char * cache_name(const char * psrc, const char * pcache, const char * pext) */
+
+
+/* ------------------------------------------------------------------------- *\
+   write_file writes a header and up to two 64 byte padded blocks of data
+   into a temporary file that replaces the file path afterwards.
+\* ------------------------------------------------------------------------- */
+
+static int write_file(const char * path, const void * phdr, size_t hsize,
+                      const void * p1, size_t len1, const void * p2, size_t len2)
+{
+   static const uint8_t zero[64] = { 0 };
+
+   int    err  = 0;
+   size_t len  = strlen(path);
+   char * ptmp = (char *) malloc(len + 5);
+   FILE * pf   = NULL;
+
+   if(!ptmp)
+      return (ENOMEM);
+
+   memcpy(ptmp, path, len);
+   strcpy(ptmp + len, ".tmp");
+
+   pf = fopen(ptmp, "wb");
+   if(!pf)
+   {
+      err = errno ? errno : EACCES;
+      goto Exit;
+   }
+
+   if((fwrite(phdr, 1, hsize, pf) != hsize) ||
+      (len1 && (fwrite(p1, 1, len1, pf) != len1)) ||
+      (fwrite(zero, 1, (size_t) (ALIGN64(len1) - len1), pf) != (size_t) (ALIGN64(len1) - len1)) ||
+      (len2 && (fwrite(p2, 1, len2, pf) != len2)) ||
+      (fwrite(zero, 1, (size_t) (ALIGN64(len2) - len2), pf) != (size_t) (ALIGN64(len2) - len2)))
+   {
+      err = errno ? errno : EIO;
+   }
+
+   if(fclose(pf) && !err)
+      err = errno ? errno : EIO;
+
+   if(!err)
+   {
+#if defined (_WIN32)
+      if(!MoveFileExA(ptmp, path, MOVEFILE_REPLACE_EXISTING))
+         err = EACCES;
+#else
+      if(rename(ptmp, path))
+         err = errno ? errno : EACCES;
+#endif
+   }
+
+   if(err)
+      remove(ptmp);
+
+   Exit:;
+
+   free(ptmp);
+
+   return (err);
+} /* int write_file(...) */
+
+
+/* ========================================================================= *\
+   Cache files
+\* ========================================================================= */
+
+/* ------------------------------------------------------------------------- *\
+   str2cache_build converts a text file into a cache file.
+\* ------------------------------------------------------------------------- */
+
+int str2cache_build(const char * psrc, const char * pcache, int type, int base, char delim)
+{
+   int          err;
+   char *       pname = cache_name(psrc, pcache, CACHE_EXT);
+   MAP          map;
+   CACHE_HEADER hdr;
+   s2n_col      col;
+
+   memset(&col, 0, sizeof(col));
+   map.pdata = NULL;
+
+   if(!psrc || !pname)
+   {
+      err = psrc ? ENOMEM : EINVAL;
+      goto Exit;
+   }
+
+   memset(&hdr, 0, sizeof(hdr));
+   memcpy(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic));
+   hdr.version    = CACHE_VERSION;
+   hdr.byte_order = BYTE_ORDER_ID;
+
+   /* The time is taken before reading to detect changes while the file is converted. */
+   err = file_info(psrc, &hdr.src_size, &hdr.src_mtime);
+   if(err)
+      goto Exit;
+
+   err = map_file(psrc, &map);
+   if(err)
+      goto Exit;
+
+   err = str2col_init(&col, type, base, 0, NULL);
+   if(err)
+      goto Exit;
+
+   err = str2col_append(&col, map.pdata ? (const char *) map.pdata : "", map.size, delim);
+   if(err)
+      goto Exit;
+
+   hdr.type         = (uint32_t) type;
+   hdr.value_size   = value_size[type];
+   hdr.count        = col.length;
+   hdr.null_count   = col.null_count;
+   hdr.errors       = col.errors;
+   hdr.src_checksum = checksum(map.pdata, map.size);
+
+   err = write_file(pname, &hdr, sizeof(hdr), col.pvalues, col.length * value_size[type],
+                    col.pvalidity, (col.length + 7) >> 3);
+
+   Exit:;
+
+   unmap_file(&map);
+   str2col_free(&col);
+
+   if(pname)
+      free(pname);
+
+   return (err);
+} /* int str2cache_build(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2cache_open maps a cache file into memory.
+\* ------------------------------------------------------------------------- */
+
+int str2cache_open(s2n_cache * pc, const char * psrc, const char * pcache, int type, int flags)
+{
+   int                  err;
+   char *               pname = cache_name(psrc, pcache, CACHE_EXT);
+   MAP                  map;
+   const CACHE_HEADER * phdr;
+   uint64_t             vsize;
+   uint64_t             bsize;
+
+   map.pdata = NULL;
+
+   if(!pc || !pname)
+   {
+      err = (!pc || (!psrc && !pcache)) ? EINVAL : ENOMEM;
+      goto Exit;
+   }
+
+   memset(pc, 0, sizeof(*pc));
+
+   err = map_file(pname, &map);
+   if(err)
+      goto Exit;
+
+   err  = EILSEQ;
+   phdr = (const CACHE_HEADER *) map.pdata;
+
+   if((map.size < sizeof(CACHE_HEADER)) || memcmp(phdr->magic, CACHE_MAGIC, sizeof(phdr->magic)) ||
+      (phdr->version != CACHE_VERSION) || (phdr->byte_order != BYTE_ORDER_ID) ||
+      (phdr->type < S2N_COL_I8) || (phdr->type > S2N_COL_F64) || (type && ((uint32_t) type != phdr->type)) ||
+      (phdr->value_size != value_size[phdr->type]) || (phdr->count > (size_t) -1 / 8))
+      goto Exit;
+
+   vsize = ALIGN64(phdr->count * phdr->value_size);
+   bsize = ALIGN64((phdr->count + 7) >> 3);
+
+   if(map.size < CACHE_DATA + vsize + bsize)
+      goto Exit;
+
+   if(psrc)
+   {
+      uint64_t size;
+      int64_t  mtime;
+
+      err = file_info(psrc, &size, &mtime);
+      if(err)
+         goto Exit;
+
+      err = S2N_ESTALE;
+      if((size != phdr->src_size) || (mtime != phdr->src_mtime))
+         goto Exit;
+
+      if((flags & S2N_CACHE_VERIFY) || is_racy(pname, phdr->src_mtime))
+      {
+         MAP src;
+
+         err = map_file(psrc, &src);
+         if(err)
+            goto Exit;
+
+         err = ((src.size != size) || (checksum(src.pdata, src.size) != phdr->src_checksum)) ? S2N_ESTALE : 0;
+         unmap_file(&src);
+         if(err)
+            goto Exit;
+      }
+   }
+
+   pc->type       = (int) phdr->type;
+   pc->count      = (size_t) phdr->count;
+   pc->null_count = (size_t) phdr->null_count;
+   pc->errors     = (size_t) phdr->errors;
+   pc->pvalues    = map.pdata + CACHE_DATA;
+   pc->pvalidity  = map.pdata + CACHE_DATA + vsize;
+   pc->pmap       = (void *) map.pdata;
+   pc->map_size   = map.size;
+   pc->hmap       = map.hmap;
+
+   map.pdata = NULL; /* the mapping belongs to the cache now */
+   err = 0;
+
+   Exit:;
+
+   unmap_file(&map);
+
+   if(pname)
+      free(pname);
+
+   return (err);
+} /* int str2cache_open(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2cache_load maps a cache file that is rebuilt if required.
+\* ------------------------------------------------------------------------- */
+
+int str2cache_load(s2n_cache * pc, const char * psrc, const char * pcache, int type, int base, char delim, int flags)
+{
+   int err = str2cache_open(pc, psrc, pcache, type, flags);
+
+   if(err && psrc && (err != EINVAL) && (err != ENOMEM))
+   {
+      err = str2cache_build(psrc, pcache, type, base, delim);
+      if(!err)
+         err = str2cache_open(pc, psrc, pcache, type, 0);
+   }
+
+   return (err);
+} /* int str2cache_load(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2cache_close unmaps a cache file.
+\* ------------------------------------------------------------------------- */
+
+void str2cache_close(s2n_cache * pc)
+{
+   if(pc && pc->pmap)
+   {
+      MAP map;
+
+      map.pdata = (const uint8_t *) pc->pmap;
+      map.size  = pc->map_size;
+      map.hmap  = pc->hmap;
+
+      unmap_file(&map);
+      memset(pc, 0, sizeof(*pc));
+   }
+} /* void str2cache_close(s2n_cache * pc) */
+
+
+/* ========================================================================= *\
+   Index files
+\* ========================================================================= */
+
+/* ------------------------------------------------------------------------- *\
+   ctz32 returns the number of trailing zero bits of a nonzero value.
+\* ------------------------------------------------------------------------- */
+
+#ifdef USE_SSE2
+static int ctz32(unsigned m)
+{
+#if defined (_MSC_VER)
+   unsigned long i;
+   _BitScanForward(&i, m);
+   return ((int) i);
+#else
+   return (__builtin_ctz(m));
+#endif
+} /* int ctz32(unsigned m) */
+#endif
+
+
+/* ------------------------------------------------------------------------- *\
+   scan_rows returns the number of rows of a buffer and stores their offsets
+   in poff32 or poff64 if one of them is not NULL. The SSE2 version compares
+   16 bytes at once and visits the set bits of the resulting mask only.
+\* ------------------------------------------------------------------------- */
+
+static size_t scan_rows(const char * ps, size_t len, char delim, uint32_t * poff32, uint64_t * poff64)
+{
+   size_t rows = 0;
+   size_t i    = 0;
+
+#define ADD_ROW(pos) { size_t p_ = (pos);                         \
+                       if(p_ < len)                               \
+                       {                                          \
+                          if(poff32) poff32[rows] = (uint32_t) p_; \
+                          else if(poff64) poff64[rows] = p_;       \
+                          ++rows;                                 \
+                       } }
+
+   ADD_ROW(0);
+
+#ifdef USE_SSE2
+   {
+      const __m128i vd = _mm_set1_epi8(delim);
+
+      for(; i + 16 <= len; i += 16)
+      {
+         unsigned m = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ps + i)), vd));
+
+         while(m)
+         {
+            ADD_ROW(i + ctz32(m) + 1);
+            m &= m - 1;
+         }
+      }
+   }
+#endif
+
+   for(; i < len; ++i)
+   {
+      if(ps[i] == delim)
+         ADD_ROW(i + 1);
+   }
+
+#undef ADD_ROW
+
+   return (rows);
+} /* size_t scan_rows(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_build writes the index file of a text file.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_build(const char * psrc, const char * pindex, char delim)
+{
+   int          err;
+   char *       pname = cache_name(psrc, pindex, INDEX_EXT);
+   void *       poff  = NULL;
+   MAP          map;
+   INDEX_HEADER hdr;
+
+   map.pdata = NULL;
+
+   if(!psrc || !pname || (digit_value[(uint8_t) delim] < 64) ||
+      (delim == '+') || (delim == '-') || (delim == '.') || (delim == '~'))
+   {
+      err = (psrc && !pname) ? ENOMEM : EINVAL;
+      goto Exit;
+   }
+
+   memset(&hdr, 0, sizeof(hdr));
+   memcpy(hdr.magic, INDEX_MAGIC, sizeof(hdr.magic));
+   hdr.version    = INDEX_VERSION;
+   hdr.byte_order = BYTE_ORDER_ID;
+   hdr.delim      = (uint8_t) delim;
+
+   err = file_info(psrc, &hdr.src_size, &hdr.src_mtime);
+   if(err)
+      goto Exit;
+
+   err = map_file(psrc, &map);
+   if(err)
+      goto Exit;
+
+   hdr.width        = (map.size > UINT32_MAX) ? 8 : 4;
+   hdr.rows         = scan_rows((const char *) map.pdata, map.size, delim, NULL, NULL);
+   hdr.src_checksum = checksum(map.pdata, map.size);
+
+   if(hdr.rows)
+   {
+      poff = malloc((size_t) hdr.rows * hdr.width);
+      if(!poff)
+      {
+         err = ENOMEM;
+         goto Exit;
+      }
+
+      if(hdr.width == 4)
+         scan_rows((const char *) map.pdata, map.size, delim, (uint32_t *) poff, NULL);
+      else
+         scan_rows((const char *) map.pdata, map.size, delim, NULL, (uint64_t *) poff);
+   }
+
+   err = write_file(pname, &hdr, sizeof(hdr), poff, (size_t) hdr.rows * hdr.width, NULL, 0);
+
+   Exit:;
+
+   unmap_file(&map);
+
+   if(poff)
+      free(poff);
+
+   if(pname)
+      free(pname);
+
+   return (err);
+} /* int str2idx_build(const char * psrc, const char * pindex, char delim) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_open maps a text file and its index file.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_open(s2n_index * pi, const char * psrc, const char * pindex, char delim, int base, size_t cache_size)
+{
+   int                  err;
+   char *               pname = cache_name(psrc, pindex, INDEX_EXT);
+   MAP                  src;
+   MAP                  idx;
+   const INDEX_HEADER * phdr;
+   uint64_t             size;
+   int64_t              mtime;
+
+   src.pdata = NULL;
+   idx.pdata = NULL;
+
+   if(!pi || !psrc || !pname || (base < 0) || (base > 36))
+   {
+      err = (pi && psrc && !pname) ? ENOMEM : EINVAL;
+      goto Exit;
+   }
+
+   memset(pi, 0, sizeof(*pi));
+
+   err = map_file(pname, &idx);
+   if(err)
+      goto Exit;
+
+   err  = EILSEQ;
+   phdr = (const INDEX_HEADER *) idx.pdata;
+
+   if((idx.size < sizeof(INDEX_HEADER)) || memcmp(phdr->magic, INDEX_MAGIC, sizeof(phdr->magic)) ||
+      (phdr->version != INDEX_VERSION) || (phdr->byte_order != BYTE_ORDER_ID) ||
+      (phdr->delim != (uint8_t) delim) || (phdr->width != ((phdr->src_size > UINT32_MAX) ? 8u : 4u)) ||
+      (phdr->rows > phdr->src_size) || (idx.size < INDEX_DATA + phdr->rows * phdr->width))
+      goto Exit;
+
+   err = file_info(psrc, &size, &mtime);
+   if(err)
+      goto Exit;
+
+   err = S2N_ESTALE;
+   if((size != phdr->src_size) || (mtime != phdr->src_mtime))
+      goto Exit;
+
+   err = map_file(psrc, &src);
+   if(err)
+      goto Exit;
+
+   err = S2N_ESTALE;
+   if((src.size != size) ||
+      (is_racy(pname, phdr->src_mtime) && (checksum(src.pdata, src.size) != phdr->src_checksum)))
+      goto Exit;
+
+   if(cache_size)
+   {
+      size_t entries = 1;
+
+      while((entries < cache_size) && (entries < ((size_t) -1 >> 1) / sizeof(INDEX_ENTRY)))
+         entries <<= 1;
+
+      pi->pcache = calloc(entries, sizeof(INDEX_ENTRY));
+      if(!pi->pcache)
+      {
+         err = ENOMEM;
+         goto Exit;
+      }
+      pi->cache_mask = entries - 1;
+   }
+
+   pi->ps       = src.pdata ? (const char *) src.pdata : "";
+   pi->len      = src.size;
+   pi->rows     = (size_t) phdr->rows;
+   pi->poffsets = idx.pdata + INDEX_DATA;
+   pi->wide     = (phdr->width == 8);
+   pi->base     = base;
+   pi->delim    = delim;
+   pi->psrc_map = (void *) src.pdata;
+   pi->hsrc_map = src.hmap;
+   pi->pidx_map = (void *) idx.pdata;
+   pi->idx_size = idx.size;
+   pi->hidx_map = idx.hmap;
+
+   /* the mappings belong to the index now */
+   src.pdata = NULL;
+   idx.pdata = NULL;
+   err = 0;
+
+   Exit:;
+
+   unmap_file(&src);
+   unmap_file(&idx);
+
+   if(pname)
+      free(pname);
+
+   return (err);
+} /* int str2idx_open(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_load maps a text file and its index file that is rebuilt if
+   required.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_load(s2n_index * pi, const char * psrc, const char * pindex, char delim, int base, size_t cache_size)
+{
+   int err = str2idx_open(pi, psrc, pindex, delim, base, cache_size);
+
+   if(err && (err != EINVAL) && (err != ENOMEM))
+   {
+      err = str2idx_build(psrc, pindex, delim);
+      if(!err)
+         err = str2idx_open(pi, psrc, pindex, delim, base, cache_size);
+   }
+
+   return (err);
+} /* int str2idx_load(...) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_field returns the position and length of a row.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_field(const s2n_index * pi, size_t row, const char ** pps, size_t * plen)
+{
+   size_t start;
+   size_t end;
+
+   if(!pi || (row >= pi->rows))
+      return (ENOENT);
+
+   if(pi->wide)
+   {
+      const uint64_t * poff = (const uint64_t *) pi->poffsets;
+
+      start = (size_t) poff[row];
+      end   = (row + 1 < pi->rows) ? (size_t) poff[row + 1] - 1 : pi->len;
+   }
+   else
+   {
+      const uint32_t * poff = (const uint32_t *) pi->poffsets;
+
+      start = poff[row];
+      end   = (row + 1 < pi->rows) ? (size_t) poff[row + 1] - 1 : pi->len;
+   }
+
+   if((end > pi->len) || (start > end))
+      return (EILSEQ); /* corrupted index */
+
+   if((end == pi->len) && end && (pi->ps[end - 1] == pi->delim))
+      --end; /* delimiter at the end of the file */
+
+   *pps  = pi->ps + start;
+   *plen = end - start;
+
+   return (0);
+} /* int str2idx_field(const s2n_index * pi, size_t row, const char ** pps, size_t * plen) */
+
+
+/* ------------------------------------------------------------------------- *\
+   idx_value converts a row into a value of type S2N_COL_I64, S2N_COL_U64 or
+   S2N_COL_F64 and keeps it in the cache of the index.
+\* ------------------------------------------------------------------------- */
+
+static int idx_value(s2n_index * pi, size_t row, int type, void * pv)
+{
+   INDEX_ENTRY * pe_cache = NULL;
+   INDEX_ENTRY   e;
+   const char *  ps;
+   const char *  pend;
+   size_t        len;
+   char          buf[ROW_BUF_SIZE];
+   char *        pheap = NULL;
+   char *        pe    = NULL;
+
+   e.err = str2idx_field(pi, row, &ps, &len);
+   if(e.err)
+      return (e.err);
+
+   if(pi->pcache)
+   {
+      pe_cache = (INDEX_ENTRY *) pi->pcache + (row & pi->cache_mask);
+      if((pe_cache->type == type) && (pe_cache->row == row))
+      {
+         ++pi->hits;
+         e = *pe_cache;
+         goto Exit;
+      }
+      ++pi->misses;
+   }
+
+   pend = ps + len;
+
+   while((ps < pend) && IS_BLANK(*ps))
+      ++ps;
+
+   while((pend > ps) && IS_BLANK(pend[-1]))
+      --pend;
+
+   len = (size_t) (pend - ps);
+
+   if(pend == pi->ps + pi->len)
+   {
+      /* The parsers need a character that terminates the number at the end of the file. */
+      char * pcopy = (len < sizeof(buf)) ? buf : (pheap = (char *) malloc(len + 1));
+
+      if(!pcopy)
+         return (ENOMEM);
+
+      memcpy(pcopy, ps, len);
+      pcopy[len] = '\0';
+      ps = pcopy;
+   }
+
+   e.row  = row;
+   e.type = type;
+   e.err  = 0;
+
+   if(type == S2N_COL_I64)
+      e.v.i = str2i64_r(ps, &pe, pi->base, &e.err);
+   else if(type == S2N_COL_U64)
+      e.v.u = str2u64_r(ps, &pe, pi->base, &e.err);
+   else
+      e.v.d = str2d_r(ps, &pe, pi->base, &e.err);
+
+   if(!e.err && (pe != ps + len))
+      e.err = EINVAL; /* the row contains more than a number */
+
+   if(pheap)
+      free(pheap);
+
+   if(pe_cache)
+      *pe_cache = e;
+
+   Exit:;
+
+   if(type == S2N_COL_I64)
+      *(int64_t *) pv = e.v.i;
+   else if(type == S2N_COL_U64)
+      *(uint64_t *) pv = e.v.u;
+   else
+      *(double *) pv = e.v.d;
+
+   return (e.err);
+} /* int idx_value(s2n_index * pi, size_t row, int type, void * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_i64 converts a row into a signed integer.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_i64(s2n_index * pi, size_t row, int64_t * pv)
+{
+   return (idx_value(pi, row, S2N_COL_I64, pv));
+} /* int str2idx_i64(s2n_index * pi, size_t row, int64_t * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_u64 converts a row into an unsigned integer.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_u64(s2n_index * pi, size_t row, uint64_t * pv)
+{
+   return (idx_value(pi, row, S2N_COL_U64, pv));
+} /* int str2idx_u64(s2n_index * pi, size_t row, uint64_t * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_d converts a row into a floating point number.
+\* ------------------------------------------------------------------------- */
+
+int str2idx_d(s2n_index * pi, size_t row, double * pv)
+{
+   return (idx_value(pi, row, S2N_COL_F64, pv));
+} /* int str2idx_d(s2n_index * pi, size_t row, double * pv) */
+
+
+/* ------------------------------------------------------------------------- *\
+   str2idx_close unmaps the files of an index.
+\* ------------------------------------------------------------------------- */
+
+void str2idx_close(s2n_index * pi)
+{
+   if(pi)
+   {
+      MAP map;
+
+      map.pdata = (const uint8_t *) pi->psrc_map;
+      map.size  = pi->len;
+      map.hmap  = pi->hsrc_map;
+      unmap_file(&map);
+
+      map.pdata = (const uint8_t *) pi->pidx_map;
+      map.size  = pi->idx_size;
+      map.hmap  = pi->hidx_map;
+      unmap_file(&map);
+
+      if(pi->pcache)
+         free(pi->pcache);
+
+      memset(pi, 0, sizeof(*pi));
+   }
+} /* void str2idx_close(s2n_index * pi) */
+
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */
@@ -0,0 +1,165 @@
+/*****************************************************************************\
+*                                                                             *
+*  FILENAME :    str2num_file.h                                               *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  DESCRIPTION : file functions of str2num_file.c                             *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  COPYRIGHT :   (c) 2026 Dipl.-Ing. Klaus Lux (Aachen, Germany)              *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+*  ORIGIN :      https://github.com/klux21/str2num                            *
+*                                                                             *
+* --------------------------------------------------------------------------- *
+*                                                                             *
+* This software is provided 'as-is', without any express or implied           *
+* warranty. In no event will the authors be held liable for any damages       *
+* arising from the use of this software.                                      *
+*                                                                             *
+* Permission is granted to anyone to use this software for any purpose,       *
+* including commercial applications, and to alter it and redistribute it      *
+* freely, subject to the following restrictions:                              *
+*                                                                             *
+* 1. The origin of this software must not be misrepresented; you must not     *
+*    claim that you wrote the original software. If you use this software     *
+*    in a product, an acknowledgment in the product documentation would be    *
+*    appreciated but is not required.                                         *
+* 2. Altered source versions must be plainly marked as such, and must not be  *
+*    misrepresented as being the original software.                           *
+* 3. This notice may not be removed or altered from any source distribution.  *
+*                                                                             *
+\*****************************************************************************/
+
+
+#ifndef STR2NUM_FILE_H
+#define STR2NUM_FILE_H
+
+
+#include <errno.h>
+#include <str2num_batch.h>
+
+#ifdef ESTALE
+#define S2N_ESTALE ESTALE
+#else
+#define S2N_ESTALE 116 /* error code of outdated cache files if the system doesn't know ESTALE */
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* flags of str2cache_open and str2cache_load */
+#define S2N_CACHE_VERIFY 1 /* compare the checksum of the source file too and not just size and time */
+
+/* typed values of a cache file that is mapped into memory */
+typedef struct s2n_cache_s s2n_cache;
+struct s2n_cache_s
+{
+   int             type;       /* S2N_COL_* type of the values */
+   size_t          count;      /* number of values */
+   size_t          null_count; /* number of null values */
+   size_t          errors;     /* number of invalid fields of the source file */
+   const void *    pvalues;    /* 64 byte aligned values */
+   const uint8_t * pvalidity;  /* 64 byte aligned validity bitmap, a set bit marks a valid value */
+   void *          pmap;       /* start of the mapping */
+   size_t          map_size;   /* size of the mapping */
+   void *          hmap;       /* handle of the mapping (Windows only) */
+};
+
+/* The cache files contain a header with the type and number of the values and the size,
+   the modification time and a checksum of the source file that is followed by the values
+   and the validity bitmap in the layout of str2col_*. The cache files use the byte order
+   of the system that wrote them and are rejected on systems with another byte order.
+   If pcache is NULL then the name of the source file with the extension .s2n is used. */
+
+/* str2cache_build converts the fields of a text file that are separated by delim into
+   values of type S2N_COL_* and writes them into a cache file. */
+int  str2cache_build (const char * psrc, const char * pcache, int type, int base, char delim);
+
+/* str2cache_open maps a cache file into memory without any conversion or copy.
+   It returns S2N_ESTALE if psrc is not NULL and the source file was changed since the
+   cache file was written and EILSEQ if the cache file is invalid or of another type.
+   A type of 0 accepts all types. The checksum of the source file is compared with
+   S2N_CACHE_VERIFY and if the source file is not at least 2 seconds older than the
+   cache file, because a rewrite of the same size may keep its modification time then. */
+int  str2cache_open  (s2n_cache * pc, const char * psrc, const char * pcache, int type, int flags);
+
+/* str2cache_load maps a cache file and rebuilds it first if it is missing or outdated. */
+int  str2cache_load  (s2n_cache * pc, const char * psrc, const char * pcache, int type, int base, char delim, int flags);
+
+/* str2cache_close unmaps a cache file. */
+void str2cache_close (s2n_cache * pc);
+
+
+/* row index of a text file that is mapped into memory */
+typedef struct s2n_index_s s2n_index;
+struct s2n_index_s
+{
+   const char * ps;         /* mapped text of the source file */
+   size_t       len;        /* size of the source file */
+   size_t       rows;       /* number of rows */
+   const void * poffsets;   /* offsets of the rows (uint32_t or uint64_t) */
+   int          wide;       /* nonzero if the offsets are of type uint64_t */
+   int          base;       /* numeric base of the values */
+   char         delim;      /* delimiter of the rows */
+   void *       pcache;     /* optional cache of converted values */
+   size_t       cache_mask; /* number of entries of the cache - 1 */
+   size_t       hits;       /* number of values that were found in the cache */
+   size_t       misses;     /* number of values that were converted */
+   void *       psrc_map;   /* mapping of the source file */
+   void *       hsrc_map;   /* handle of the mapping of the source file (Windows only) */
+   void *       pidx_map;   /* mapping of the index file */
+   size_t       idx_size;   /* size of the mapping of the index file */
+   void *       hidx_map;   /* handle of the mapping of the index file (Windows only) */
+};
+
+/* The index files contain the offsets of the rows of a text file that are separated by
+   delim. The offsets are 32 bit values for files that are smaller than 4 GiB and 64 bit
+   values otherwise. If pindex is NULL then the name of the source file with the extension
+   .s2i is used. The delimiter must not be a character that may be part of a number. */
+
+/* str2idx_build scans a text file once and writes the offsets of its rows into an index file. */
+int  str2idx_build  (const char * psrc, const char * pindex, char delim);
+
+/* str2idx_open maps a text file and its index file into memory. It returns S2N_ESTALE if the
+   text file was changed since the index was written and EILSEQ if the index is invalid or was
+   written for another delimiter. The checksum of the text file is compared if it is not at
+   least 2 seconds older than the index file like for str2cache_open. cache_size is the
+   number of converted values that are kept in a direct mapped cache. It is rounded up to a
+   power of two and 0 disables the cache. str2idx_i64, str2idx_u64 and str2idx_d update the
+   cache and the counters hits and misses of the index, so an index must not be used by
+   several threads at once. Threads may open their own index of the same files instead. */
+int  str2idx_open   (s2n_index * pi, const char * psrc, const char * pindex, char delim, int base, size_t cache_size);
+
+/* str2idx_load maps a text file and its index file and rebuilds the index first if it is
+   missing or outdated. */
+int  str2idx_load   (s2n_index * pi, const char * psrc, const char * pindex, char delim, int base, size_t cache_size);
+
+/* str2idx_field returns the position and length of a row without the delimiter or ENOENT if
+   row is not less than the number of rows. */
+int  str2idx_field  (const s2n_index * pi, size_t row, const char ** pps, size_t * plen);
+
+/* str2idx_* convert a row on demand. They return 0, ENOENT if the row doesn't exist, ERANGE
+   if the value is out of range or EINVAL if the row doesn't contain a single valid number that
+   may be surrounded by blanks. The value of the conversion is stored in any case. */
+int  str2idx_i64    (s2n_index * pi, size_t row, int64_t  * pv);
+int  str2idx_u64    (s2n_index * pi, size_t row, uint64_t * pv);
+int  str2idx_d      (s2n_index * pi, size_t row, double   * pv);
+
+/* str2idx_close unmaps the files of an index and releases the cache. */
+void str2idx_close  (s2n_index * pi);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif
+
+#endif /* STR2NUM_FILE_H */
+
+/* ========================================================================= *\
+   E N D   O F   F I L E
+\* ========================================================================= */